@@ -0,0 +1,48 @@
+/*
+ * bench.h
+ *
+ *  Timing helpers shared by the host benchmarks
+ */
+
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+//	Monotonic time in nanoseconds
+static inline double benchNow(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return ((double)t.tv_sec * 1e9) + (double)t.tv_nsec;
+}
+
+
+//	Keeps the compiler from dropping work whose result is never used
+static volatile float benchSink;
+
+
+//	Repetitions so that a run of n samples per repetition processes about 2^22 samples in total
+static inline int benchRepetitions(size_t n)
+{
+	size_t reps = ((size_t)1 << 22) / n;
+
+	return (reps < 1) ? 1 : (int)reps;
+}
+
+
+//	Uniform noise in [-1, 1)
+static inline void benchNoise(float *x, size_t n, unsigned int seed)
+{
+	srand(seed);
+
+	for (size_t i = 0; i < n; ++i)
+		x[i] = ((float)rand() / ((float)RAND_MAX + 1.f) * 2.f) - 1.f;
+}
+
+
+#endif /* BENCH_BENCH_H_ */
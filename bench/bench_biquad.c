@@ -0,0 +1,152 @@
+/*
+ * bench_biquad.c
+ *
+ *  Butterworth BiquadCascade lowpasses against FIRFilter (and the shift-register filterAudioBlock() main.c used to
+ *  run) with a Kaiser FIR of the same stopband attenuation: CPU per sample at each order
+ */
+
+#include "bench.h"
+#include "fir_config.h"
+#include "FIRFilter.h"
+#include "BiquadCascade.h"
+#include <math.h>
+
+
+#define NUM_BLOCKS 16
+#define IR_LENGTH 8192
+#define MAX_TAPS 511
+
+//	Passband edge (the cutoff) and stopband edge, an octave above it
+#define STOPBAND_EDGE (2.f * BENCH_FIR_FC)
+
+
+//	Worst-case gain in dB of the impulse response h over [STOPBAND_EDGE, fs / 2], on a 25 Hz grid
+static float32_t benchStopbandGain(const float32_t *h, size_t n)
+{
+	double worst = 0.0;
+
+	for (double f = STOPBAND_EDGE; f <= BENCH_FIR_FS / 2.f; f += 25.0)
+	{
+		double w = 2.0 * M_PI * f / BENCH_FIR_FS;
+		double re = 0.0, im = 0.0;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			re += h[i] * cos(w * (double)i);
+			im -= h[i] * sin(w * (double)i);
+		}
+
+		double g = (re * re) + (im * im);
+		if (g > worst)
+			worst = g;
+	}
+
+	return (float32_t)(10.0 * log10(worst));
+}
+
+
+int main(void)
+{
+	static float32_t x[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t y[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t impulse[IR_LENGTH];
+	static float32_t ir[IR_LENGTH];
+	static float32_t h[MAX_TAPS];
+
+	benchNoise(x, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE, 1);
+	impulse[0] = 1.f;
+
+	static const size_t orders[] = {4, 8, 12, 16};
+
+	printf("lowpass, passband edge %.0f Hz, stopband from %.0f Hz at fs %.0f Hz, block %d, ns/sample\n", BENCH_FIR_FC,
+		   STOPBAND_EDGE, BENCH_FIR_FS, BENCH_FIR_BLOCK_SIZE);
+	printf("MACs per sample, and the biquad's time against FIRFilter's (below 1 = FIRFilter faster)\n");
+	printf("%5s %11s %5s %11s %12s %9s %16s %10s %10s %9s\n", "order", "biquad, dB", "taps", "FIR, dB", "biquad MACs",
+		   "FIR MACs", "filterAudioBlock", "FIRFilter", "biquad", "speedup");
+
+	size_t biquadWins = 0;
+
+	for (size_t k = 0; k < sizeof(orders) / sizeof(orders[0]); ++k)
+	{
+		//	The Butterworth's stopband attenuation is its gain at the stopband edge
+		BiquadCascade cascade;
+		BiquadCascade *c = &cascade;
+		if ((biquadCascadeDesign(c, BIQUAD_BUTTERWORTH, BIQUAD_LOWPASS, orders[k], BENCH_FIR_FC, BENCH_FIR_FS) < 0))
+			return 1;
+
+		biquadCascadeProcessBlock(c, impulse, ir, IR_LENGTH);
+		float32_t biquadGain = benchStopbandGain(ir, IR_LENGTH);
+
+		//	A Kaiser FIR with the same attenuation and its transition band between the two edges
+		float32_t attenuation = -biquadGain;
+		uint32_t numTaps = fir_kaiserNumTaps(attenuation, STOPBAND_EDGE - BENCH_FIR_FC, BENCH_FIR_FS);
+		if ((numTaps > MAX_TAPS) || (fir_calculateWindowedLPFCoefficients(0.5f * (BENCH_FIR_FC + STOPBAND_EDGE),
+				BENCH_FIR_FS, numTaps, FIR_WINDOW_KAISER, fir_kaiserBeta(attenuation), h) < 0))
+			return 1;
+
+		float32_t firGain = benchStopbandGain(h, numTaps);
+
+		//	The shift register moves all numTaps samples for every output, so it is timed over fewer repetitions
+		BenchShiftFIR shift;
+		if (benchCreateShiftFIR(&shift, numTaps) < 0)
+			return 1;
+
+		int reps = benchRepetitions(NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE * numTaps / 16);
+
+		double t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+				benchFilterAudioBlock(&shift, x + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE, h,
+									  y + (b * BENCH_FIR_BLOCK_SIZE));
+		}
+		double t1 = benchNow();
+		benchSink = y[0];
+
+		double shiftNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+		benchDeleteShiftFIR(&shift);
+
+		reps = benchRepetitions(NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		FIRFilter *f = createFIRFilter(h, numTaps, BENCH_FIR_BLOCK_SIZE);
+		if (f == NULL)
+			return 1;
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+				firFilterProcessBlock(f, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+		}
+		t1 = benchNow();
+		benchSink = y[0];
+
+		double firNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+		deleteFIRFilter(f);
+
+		biquadCascadeReset(c);
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+				biquadCascadeProcessBlock(c, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+		}
+		t1 = benchNow();
+		benchSink = y[0];
+
+		double biquadNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		//	Five per second order section, and the folded kernel's multiplies for the linear-phase FIR
+		printf("%5zu %11.1f %5u %11.1f %12zu %9u %16.2f %10.2f %10.2f %8.2fx\n", orders[k], biquadGain, numTaps, firGain,
+			   5 * (orders[k] / 2), (numTaps + 1) / 2, shiftNs, firNs, biquadNs, firNs / biquadNs);
+
+		if (biquadNs < firNs)
+			++biquadWins;
+	}
+
+	printf("On this host the biquad cascade beats FIRFilter at %zu of %zu orders, despite the fewer MACs: the biquad\n"
+		   "recursion is serial while FIRFilter's kernels are vectorized\n", biquadWins, sizeof(orders) / sizeof(orders[0]));
+
+	return 0;
+}
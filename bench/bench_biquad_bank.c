@@ -0,0 +1,185 @@
+/*
+ * bench_biquad_bank.c
+ *
+ *  10 band (octave) and 31 band (third octave) graphic EQs: BiquadBank against one BiquadCascade per band, each run
+ *  over the block on its own the way a separate filter loop per band would be, with summed and separate outputs
+ */
+
+#include "bench.h"
+#include "fir_config.h"
+#include "BiquadCascade.h"
+#include "BiquadBank.h"
+#include <math.h>
+
+
+#define NUM_BLOCKS 16
+
+
+//	Largest difference between y and reference
+static float32_t benchMaxError(const float32_t *y, const float32_t *reference, size_t n)
+{
+	float32_t e = 0.f;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (fabsf(y[i] - reference[i]) > e)
+			e = fabsf(y[i] - reference[i]);
+	}
+
+	return e;
+}
+
+
+int main(void)
+{
+	static float32_t x[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t reference[BIQUAD_BANK_MAX_BANDS][NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t bands[BIQUAD_BANK_MAX_BANDS][NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t referenceSum[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t y[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static BiquadCascade cascades[BIQUAD_BANK_MAX_BANDS];
+
+	benchNoise(x, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE, 1);
+
+	//	Octave bands from 31.25 Hz and third octave bands from 15.6 Hz, both up to 16 kHz
+	struct
+	{
+		size_t numBands;
+		float32_t fLow;
+		float32_t bandsPerOctave;
+	}eqs[] = {
+		{10, 31.25f, 1.f},
+		{31, 15.625f, 3.f},
+	};
+
+	printf("graphic EQ, fs %.0f Hz, block %d, ns/sample (speedup over one BiquadCascade per band)\n", BENCH_FIR_FS,
+		   BENCH_FIR_BLOCK_SIZE);
+	printf("%5s %17s %18s %17s %18s %10s\n", "bands", "cascades, summed", "bank, summed", "cascades, separate",
+		   "bank, separate", "max error");
+
+	for (size_t e = 0; e < sizeof(eqs) / sizeof(eqs[0]); ++e)
+	{
+		size_t numBands = eqs[e].numBands;
+		float32_t Q = sqrtf(powf(2.f, 1.f / eqs[e].bandsPerOctave)) / (powf(2.f, 1.f / eqs[e].bandsPerOctave) - 1.f);
+		int reps = benchRepetitions(NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE * numBands) * 4;
+
+		BiquadBank *bank = createBiquadBank(numBands, BENCH_FIR_BLOCK_SIZE);
+		if (bank == NULL)
+			return 1;
+
+		//	Alternating boosts and cuts, and the same bands as single stage cascades
+		for (size_t k = 0; k < numBands; ++k)
+		{
+			float32_t fc = eqs[e].fLow * powf(2.f, (float32_t)k / eqs[e].bandsPerOctave);
+
+			if (biquadBankDesignBand(bank, k, fc, Q, (k % 2 == 0) ? 1.4f : 0.7f, BENCH_FIR_FS) < 0)
+				return 1;
+
+			float32_t coeffs[5] = {bank->b0[k], bank->b1[k], bank->b2[k], bank->a1[k], bank->a2[k]};
+			if (biquadCascadeInit(&cascades[k], 1, coeffs) < 0)
+				return 1;
+		}
+
+		float32_t *bandPointers[BIQUAD_BANK_MAX_BANDS];
+		for (size_t k = 0; k < numBands; ++k)
+			bandPointers[k] = bands[k];
+
+		//	One cascade per band, each over the whole block, added up
+		double t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			{
+				size_t offset = b * BENCH_FIR_BLOCK_SIZE;
+
+				arm_fill_f32(0.f, referenceSum + offset, BENCH_FIR_BLOCK_SIZE);
+				for (size_t k = 0; k < numBands; ++k)
+				{
+					biquadCascadeProcessBlock(&cascades[k], x + offset, y + offset, BENCH_FIR_BLOCK_SIZE);
+					arm_add_f32(referenceSum + offset, y + offset, referenceSum + offset, BENCH_FIR_BLOCK_SIZE);
+				}
+			}
+		}
+		double t1 = benchNow();
+		benchSink = referenceSum[0];
+		double cascadeSumNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			{
+				size_t offset = b * BENCH_FIR_BLOCK_SIZE;
+
+				for (size_t k = 0; k < numBands; ++k)
+					biquadCascadeProcessBlock(&cascades[k], x + offset, reference[k] + offset, BENCH_FIR_BLOCK_SIZE);
+			}
+		}
+		t1 = benchNow();
+		benchSink = reference[0][0];
+		double cascadeSeparateNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+				biquadBankProcessBlock(bank, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+		}
+		t1 = benchNow();
+		benchSink = y[0];
+		double bankSumNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			{
+				float32_t *out[BIQUAD_BANK_MAX_BANDS];
+				for (size_t k = 0; k < numBands; ++k)
+					out[k] = bandPointers[k] + (b * BENCH_FIR_BLOCK_SIZE);
+
+				biquadBankProcessBlockSeparate(bank, x + (b * BENCH_FIR_BLOCK_SIZE), out, BENCH_FIR_BLOCK_SIZE);
+			}
+		}
+		t1 = benchNow();
+		benchSink = bands[0][0];
+		double bankSeparateNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		//	Both from a clean state over the same input, to check that the bank computes what the cascades do
+		biquadBankReset(bank);
+		for (size_t k = 0; k < numBands; ++k)
+			biquadCascadeReset(&cascades[k]);
+
+		arm_fill_f32(0.f, referenceSum, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+		for (size_t k = 0; k < numBands; ++k)
+		{
+			biquadCascadeProcessBlock(&cascades[k], x, reference[k], NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+			arm_add_f32(referenceSum, reference[k], referenceSum, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+		}
+
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			biquadBankProcessBlock(bank, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+
+		float32_t maxError = benchMaxError(y, referenceSum, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		biquadBankReset(bank);
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+		{
+			float32_t *out[BIQUAD_BANK_MAX_BANDS];
+			for (size_t k = 0; k < numBands; ++k)
+				out[k] = bandPointers[k] + (b * BENCH_FIR_BLOCK_SIZE);
+
+			biquadBankProcessBlockSeparate(bank, x + (b * BENCH_FIR_BLOCK_SIZE), out, BENCH_FIR_BLOCK_SIZE);
+		}
+
+		for (size_t k = 0; k < numBands; ++k)
+			maxError = fmaxf(maxError, benchMaxError(bands[k], reference[k], NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE));
+
+		deleteBiquadBank(bank);
+
+		printf("%5zu %17.2f %9.2f (%5.1fx) %17.2f %9.2f (%5.1fx) %10.2e\n", numBands, cascadeSumNs, bankSumNs,
+			   cascadeSumNs / bankSumNs, cascadeSeparateNs, bankSeparateNs, cascadeSeparateNs / bankSeparateNs, maxError);
+	}
+
+	return 0;
+}
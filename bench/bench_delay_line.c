@@ -0,0 +1,53 @@
+/*
+ * bench_delay_line.c
+ *
+ *  delayLineProcessBlock() against a loop of delayLineShift() calls, for block sizes 32 to 2048
+ */
+
+#include "bench.h"
+#include "DelayLine.h"
+
+
+#define DELAY 2000
+#define MAX_BLOCK 2048
+
+
+int main(void)
+{
+	static float32_t x[MAX_BLOCK];
+	static float32_t y[MAX_BLOCK];
+
+	DelayLine *a = createDelayLine(DELAY);
+	DelayLine *b = createDelayLine(DELAY);
+	if ((a == NULL) || (b == NULL))
+		return 1;
+
+	benchNoise(x, MAX_BLOCK, 1);
+
+	printf("delay line, M = %d\n", DELAY);
+	printf("%8s %22s %22s\n", "block", "per-sample ns/sample", "block ns/sample");
+
+	for (size_t n = 32; n <= MAX_BLOCK; n *= 2)
+	{
+		int reps = benchRepetitions(n);
+
+		double t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t i = 0; i < n; ++i)
+				delayLineShift(a, x[i], &y[i]);
+		}
+		double t1 = benchNow();
+		for (int r = 0; r < reps; ++r)
+			delayLineProcessBlock(b, x, y, n);
+		double t2 = benchNow();
+
+		benchSink = y[n - 1];
+		printf("%8zu %22.2f %22.2f\n", n, (t1 - t0) / reps / n, (t2 - t1) / reps / n);
+	}
+
+	deleteDelayLine(a);
+	deleteDelayLine(b);
+
+	return 0;
+}
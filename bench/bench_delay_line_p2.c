@@ -0,0 +1,249 @@
+/*
+ * bench_delay_line_p2.c
+ *
+ *  DelayLineP2 (runtime and compile-time sized) against DelayLine, in a feedback comb filter and in the per-sample
+ *  reverberator main.c used to run, with the current block paths for reference
+ */
+
+#include "bench.h"
+#include "reverb_config.h"
+#include "DelayLineP2.h"
+
+
+#define BLOCK 512
+#define COMB_M 1687
+#define COMB_AM -0.77f
+
+DECLARE_STATIC_DELAY_LINE(StaticComb, COMB_M)
+
+DECLARE_STATIC_DELAY_LINE(StaticAP0, 347)
+DECLARE_STATIC_DELAY_LINE(StaticAP1, 113)
+DECLARE_STATIC_DELAY_LINE(StaticAP2, 37)
+DECLARE_STATIC_DELAY_LINE(StaticFB0, 1687)
+DECLARE_STATIC_DELAY_LINE(StaticFB1, 1601)
+DECLARE_STATIC_DELAY_LINE(StaticFB2, 2053)
+DECLARE_STATIC_DELAY_LINE(StaticFB3, 2251)
+
+
+//	FBCF on a DelayLineP2, the same arithmetic as fbcfShift() with b0 = 1
+static inline float32_t p2FBCF(DelayLineP2 *d, float32_t am, float32_t x)
+{
+	float32_t delayOut;
+	delayLineP2Peek(d, &delayOut);
+
+	float32_t v = (delayOut * am) + x;
+	delayLineP2Shift(d, v, &delayOut);
+
+	return v;
+}
+
+
+//	The APCF of createAPCF(M, -g, g): an FFCF (b0 = -g, bm = 1) into an FBCF (am = g)
+static inline float32_t p2APCF(DelayLineP2 *ff, DelayLineP2 *fb, float32_t g, float32_t x)
+{
+	float32_t delayOut;
+	delayLineP2Shift(ff, x, &delayOut);
+
+	return p2FBCF(fb, g, (x * -g) + delayOut);
+}
+
+
+typedef struct
+{
+	DelayLineP2 *apFF[BENCH_REVERB_NUM_APCFS];
+	DelayLineP2 *apFB[BENCH_REVERB_NUM_APCFS];
+	DelayLineP2 *fb[BENCH_REVERB_NUM_FBCFS];
+}P2Reverb;
+
+
+static float32_t p2Reverb(P2Reverb *r, float32_t x)
+{
+	for (size_t i = 0; i < BENCH_REVERB_NUM_APCFS; ++i)
+		x = p2APCF(r->apFF[i], r->apFB[i], 0.7f, x);
+
+	float32_t sum = 0.f;
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+		sum += p2FBCF(r->fb[i], -benchFBGains[i], x);
+
+	return sum;
+}
+
+
+typedef struct
+{
+	StaticAP0 ff0, fb0;
+	StaticAP1 ff1, fb1;
+	StaticAP2 ff2, fb2;
+	StaticFB0 c0;
+	StaticFB1 c1;
+	StaticFB2 c2;
+	StaticFB3 c3;
+}StaticReverb;
+
+
+#define STATIC_APCF(Type, ff, fb, g, x)							\
+	do															\
+	{															\
+		float32_t delayOut = Type##Shift(&(ff), (x));			\
+		float32_t v = (Type##Peek(&(fb)) * (g)) + ((x) * -(g)) + delayOut;	\
+		Type##Shift(&(fb), v);									\
+		(x) = v;												\
+	}while (0)
+
+#define STATIC_FBCF(Type, line, am, x, sum)						\
+	do															\
+	{															\
+		float32_t v = (Type##Peek(&(line)) * (am)) + (x);		\
+		Type##Shift(&(line), v);								\
+		(sum) += v;												\
+	}while (0)
+
+
+static float32_t staticReverb(StaticReverb *r, float32_t x)
+{
+	float32_t sum = 0.f;
+
+	STATIC_APCF(StaticAP0, r->ff0, r->fb0, 0.7f, x);
+	STATIC_APCF(StaticAP1, r->ff1, r->fb1, 0.7f, x);
+	STATIC_APCF(StaticAP2, r->ff2, r->fb2, 0.7f, x);
+	STATIC_FBCF(StaticFB0, r->c0, -benchFBGains[0], x, sum);
+	STATIC_FBCF(StaticFB1, r->c1, -benchFBGains[1], x, sum);
+	STATIC_FBCF(StaticFB2, r->c2, -benchFBGains[2], x, sum);
+	STATIC_FBCF(StaticFB3, r->c3, -benchFBGains[3], x, sum);
+
+	return sum;
+}
+
+
+int main(void)
+{
+	static float32_t x[BLOCK];
+	static float32_t y[BLOCK];
+	static float32_t check[BLOCK];
+	static float32_t reference[BLOCK];
+	static StaticComb staticComb;
+	static StaticReverb staticRev;
+	int reps = 20000;
+
+	benchAudio(x, BLOCK, 0, BLOCK);
+
+	//	Comb path
+	FBCF *comb = createFBCF(COMB_M, 1.f, COMB_AM);
+	FBCF *blockComb = createFBCF(COMB_M, 1.f, COMB_AM);
+	DelayLineP2 *p2Comb = createDelayLineP2(COMB_M);
+	StaticCombInit(&staticComb);
+
+	double t0 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			fbcfShift(comb, x[i], &reference[i]);
+	}
+	double t1 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			check[i] = p2FBCF(p2Comb, COMB_AM, x[i]);
+	}
+	double t2 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+		{
+			float32_t v = (StaticCombPeek(&staticComb) * COMB_AM) + x[i];
+			StaticCombShift(&staticComb, v);
+			y[i] = v;
+		}
+	}
+	double t3 = benchNow();
+	for (int r = 0; r < reps; ++r)
+		fbcfProcessBlock(blockComb, x, y, BLOCK);
+	double t4 = benchNow();
+
+	int combMatch = (memcmp(reference, check, sizeof(check)) == 0);
+
+	printf("feedback comb, M = %d, block %d, ns/sample\n", COMB_M, BLOCK);
+	printf("  DelayLine per-sample (fbcfShift)    %6.2f\n", (t1 - t0) / reps / BLOCK);
+	printf("  DelayLineP2 per-sample              %6.2f\n", (t2 - t1) / reps / BLOCK);
+	printf("  static DelayLineP2 per-sample       %6.2f\n", (t3 - t2) / reps / BLOCK);
+	printf("  DelayLine block (fbcfProcessBlock)  %6.2f\n", (t4 - t3) / reps / BLOCK);
+	printf("  DelayLine and DelayLineP2 outputs match: %s\n", combMatch ? "yes" : "no");
+
+	//	Reverb path, main.c's delay lengths and gains
+	BenchShiftReverb shiftRev;
+	P2Reverb p2Rev;
+	if (benchCreateShiftReverb(&shiftRev) < 0)
+		return 1;
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_APCFS; ++i)
+	{
+		p2Rev.apFF[i] = createDelayLineP2(benchAPDelayLengths[i]);
+		p2Rev.apFB[i] = createDelayLineP2(benchAPDelayLengths[i]);
+	}
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+		p2Rev.fb[i] = createDelayLineP2(benchFBDelayLengths[i]);
+
+	StaticAP0Init(&staticRev.ff0); StaticAP0Init(&staticRev.fb0);
+	StaticAP1Init(&staticRev.ff1); StaticAP1Init(&staticRev.fb1);
+	StaticAP2Init(&staticRev.ff2); StaticAP2Init(&staticRev.fb2);
+	StaticFB0Init(&staticRev.c0); StaticFB1Init(&staticRev.c1);
+	StaticFB2Init(&staticRev.c2); StaticFB3Init(&staticRev.c3);
+
+	SchroederReverbConfig config = benchReverbConfig(DELAY_LINE_FORMAT_F32, 1.f);
+	SchroederReverb *blockRev = createSchroederReverb(&config);
+	if (blockRev == NULL)
+		return 1;
+
+	float32_t maxDiff = 0.f;
+	reps = 4000;
+
+	t0 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			y[i] = benchShiftReverb(&shiftRev, x[i]);
+	}
+	t1 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			check[i] = p2Reverb(&p2Rev, x[i]);
+	}
+	t2 = benchNow();
+
+	for (size_t i = 0; i < BLOCK; ++i)
+	{
+		float32_t d = fabsf(y[i] - check[i]) / (fabsf(y[i]) + 1.f);
+		if (d > maxDiff)
+			maxDiff = d;
+	}
+
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			y[i] = staticReverb(&staticRev, x[i]);
+	}
+	t3 = benchNow();
+	for (int r = 0; r < reps; ++r)
+		schroederReverbProcessBlock(blockRev, x, y, BLOCK);
+	t4 = benchNow();
+
+	benchSink = y[0] + check[0];
+
+	printf("\nreverberator, main.c delays, block %d, ns/sample\n", BLOCK);
+	printf("  DelayLine per-sample (shiftSchroederReverberator)  %6.2f\n", (t1 - t0) / reps / BLOCK);
+	printf("  DelayLineP2 per-sample                             %6.2f\n", (t2 - t1) / reps / BLOCK);
+	printf("  static DelayLineP2 per-sample                      %6.2f\n", (t3 - t2) / reps / BLOCK);
+	printf("  DelayLine block (schroederReverbProcessBlock)      %6.2f\n", (t4 - t3) / reps / BLOCK);
+	printf("  largest relative difference DelayLine/P2: %.2g\n", maxDiff);
+
+	benchDeleteShiftReverb(&shiftRev);
+	deleteSchroederReverb(blockRev);
+	deleteFBCF(comb);
+	deleteFBCF(blockComb);
+	deleteDelayLineP2(p2Comb);
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * bench_denormal.c
+ *
+ *  An impulse followed by a long silence through main.c's reverberator, on the block path and on the per-sample path
+ *  it used to run, reporting the typical and the worst block time as the tail decays into the subnormal range.
+ *  The Makefile builds it once per protection mode in Denormal.h, with BENCH_DENORMAL_MODE naming the build
+ */
+
+#include "bench.h"
+#include "reverb_config.h"
+#include "Denormal.h"
+
+
+#ifndef BENCH_DENORMAL_MODE
+#define BENCH_DENORMAL_MODE "default"
+#endif
+
+#define SECONDS 40
+#define NUM_BLOCKS ((SECONDS * 30000) / BENCH_REVERB_BLOCK_SIZE)		//	BENCH_REVERB_FS is a float
+#define RUNS 3
+
+//	Blocks before anything in the reverberator can be subnormal.  The shortest APCF (37 samples with a gain of 0.7)
+//	gets there first, after about 0.3 s
+#define EARLY_BLOCKS 3
+
+
+static int compareDouble(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+
+//	Typical block time over the first EARLY_BLOCKS blocks and worst block time overall, out of the fastest of RUNS runs
+//	of every block so that a block the OS happened to interrupt in one run doesn't count as the worst case
+static void benchReport(const char *name, double (*times)[NUM_BLOCKS], const size_t *subnormalBlock)
+{
+	static double best[NUM_BLOCKS];
+	static double sorted[EARLY_BLOCKS];
+	size_t worst = 0;
+
+	for (size_t b = 0; b < NUM_BLOCKS; ++b)
+	{
+		best[b] = times[0][b];
+
+		for (size_t run = 1; run < RUNS; ++run)
+			best[b] = (times[run][b] < best[b]) ? times[run][b] : best[b];
+
+		if (b < EARLY_BLOCKS)
+			sorted[b] = best[b];
+
+		worst = (best[b] > best[worst]) ? b : worst;
+	}
+
+	qsort(sorted, EARLY_BLOCKS, sizeof(double), compareDouble);
+
+	double median = sorted[EARLY_BLOCKS / 2];
+	double samplesPerSecond = BENCH_REVERB_FS;
+
+	printf("%-30s %10.1f %10.1f %8.1fx %9.1f", name, median / 1000.0, best[worst] / 1000.0, best[worst] / median,
+		   (double)(worst * BENCH_REVERB_BLOCK_SIZE) / samplesPerSecond);
+
+	if (*subnormalBlock < NUM_BLOCKS)
+		printf(" %22.1f\n", (double)(*subnormalBlock * BENCH_REVERB_BLOCK_SIZE) / samplesPerSecond);
+	else
+		printf(" %22s\n", "never");
+}
+
+
+//	Index of the first block whose output has a subnormal sample, or NUM_BLOCKS
+static void benchFindSubnormal(const float32_t *y, size_t b, size_t *subnormalBlock)
+{
+	if (*subnormalBlock < NUM_BLOCKS)
+		return;
+
+	for (size_t i = 0; i < BENCH_REVERB_BLOCK_SIZE; ++i)
+	{
+		if ((y[i] != 0.f) && (fabsf(y[i]) < 1.17549435e-38f))
+		{
+			*subnormalBlock = b;
+			return;
+		}
+	}
+}
+
+
+int main(void)
+{
+	static float32_t x[BENCH_REVERB_BLOCK_SIZE];
+	static float32_t y[BENCH_REVERB_BLOCK_SIZE];
+	static double times[RUNS][NUM_BLOCKS];
+	size_t subnormalBlock;
+
+	printf("impulse then %d s of silence, %d-sample blocks, protection: %s\n", SECONDS, BENCH_REVERB_BLOCK_SIZE, BENCH_DENORMAL_MODE);
+	printf("%-30s %10s %10s %9s %9s %22s\n", "engine", "early us", "worst us", "ratio", "worst at s", "output subnormal at s");
+
+	//	Block path, which turns flush-to-zero on itself when DENORMAL_PROTECTION_FTZ is set
+	SchroederReverbConfig config = benchReverbConfig(DELAY_LINE_FORMAT_F32, 1.f);
+	SchroederReverb *blockRev = createSchroederReverb(&config);
+	if (blockRev == NULL)
+		return 1;
+
+	for (size_t run = 0; run < RUNS; ++run)
+	{
+		schroederReverbReset(blockRev);
+		subnormalBlock = NUM_BLOCKS;
+
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+		{
+			arm_fill_f32(0.f, x, BENCH_REVERB_BLOCK_SIZE);
+			x[0] = (b == 0) ? 1.f : 0.f;
+
+			double t0 = benchNow();
+			schroederReverbProcessBlock(blockRev, x, y, BENCH_REVERB_BLOCK_SIZE);
+			times[run][b] = benchNow() - t0;
+
+			benchFindSubnormal(y, b, &subnormalBlock);
+		}
+	}
+
+	benchReport("schroederReverbProcessBlock", times, &subnormalBlock);
+	deleteSchroederReverb(blockRev);
+
+	//	Per-sample path, with the guard around each block the way a host would call it
+	for (size_t run = 0; run < RUNS; ++run)
+	{
+		BenchShiftReverb shiftRev;
+		if (benchCreateShiftReverb(&shiftRev) < 0)
+			return 1;
+
+		subnormalBlock = NUM_BLOCKS;
+
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+		{
+			arm_fill_f32(0.f, x, BENCH_REVERB_BLOCK_SIZE);
+			x[0] = (b == 0) ? 1.f : 0.f;
+
+			double t0 = benchNow();
+			DenormalState state = denormalGuardBegin();
+
+			for (size_t i = 0; i < BENCH_REVERB_BLOCK_SIZE; ++i)
+				y[i] = benchShiftReverb(&shiftRev, x[i]);
+
+			denormalGuardEnd(state);
+			times[run][b] = benchNow() - t0;
+
+			benchFindSubnormal(y, b, &subnormalBlock);
+		}
+
+		benchDeleteShiftReverb(&shiftRev);
+	}
+
+	benchReport("shiftSchroederReverberator", times, &subnormalBlock);
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * bench_fbcf_bank.c
+ *
+ *  FBCFBank against the per-comb kernels it replaces (one fbcfProcessBlock() per comb, then the outputs summed) and
+ *  against the per-sample fbcfShift() loop of shiftSchroederReverberator(), for banks of 4, 8 and 16 combs
+ */
+
+#include "bench.h"
+#include "reverb_config.h"
+#include "FBCFBank.h"
+#include <math.h>
+
+
+#define BLOCK BENCH_REVERB_BLOCK_SIZE
+
+
+//	N = 4 is main.c's comb section, the larger banks add mutually prime lengths below it
+static const size_t bankLengths[16] = {1687, 1601, 2053, 2251, 1009, 1163, 1327, 1481, 557, 613, 701, 787, 877, 971,
+									   1063, 1151};
+
+
+int main(void)
+{
+	static float32_t x[BLOCK];
+	static float32_t y[BLOCK];
+	static float32_t comb[BLOCK];
+	static float32_t reference[BLOCK];
+	float32_t b0[16];
+	float32_t am[16];
+
+	benchAudio(x, BLOCK, 0, BLOCK);
+	arm_offset_f32(x, -BENCH_ADC_MID_SCALE, x, BLOCK);
+
+	for (size_t j = 0; j < 16; ++j)
+	{
+		b0[j] = 1.f;
+		am[j] = benchFBGains[j % BENCH_REVERB_NUM_FBCFS];
+	}
+
+	static const size_t sizes[] = {4, 8, 16};
+
+	printf("parallel feedback combs, block %d, ns/sample (speedup of the bank over the per-comb kernels)\n", BLOCK);
+	printf("%5s %14s %17s %18s %10s\n", "combs", "fbcfShift", "fbcfProcessBlock", "fbcfBank", "rel. error");
+
+	for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k)
+	{
+		size_t N = sizes[k];
+		int reps = benchRepetitions(BLOCK * N) * 4;
+		FBCF *combs[16];
+		FBCF *shiftCombs[16];
+
+		for (size_t j = 0; j < N; ++j)
+		{
+			combs[j] = createFBCF(bankLengths[j], b0[j], am[j]);
+			shiftCombs[j] = createFBCF(bankLengths[j], b0[j], am[j]);
+			if ((combs[j] == NULL) || (shiftCombs[j] == NULL))
+				return 1;
+		}
+
+		FBCFBank *bank = createFBCFBank(N, bankLengths, b0, am);
+		if (bank == NULL)
+			return 1;
+
+		//	The comb loop of shiftSchroederReverberator(), one sample through every comb at a time
+		double t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t i = 0; i < BLOCK; ++i)
+			{
+				float32_t sum = 0.f;
+
+				for (size_t j = 0; j < N; ++j)
+				{
+					float32_t out;
+					fbcfShift(shiftCombs[j], x[i], &out);
+					sum += out;
+				}
+
+				y[i] = sum;
+			}
+		}
+		double t1 = benchNow();
+		benchSink = y[0];
+		double shiftNs = (t1 - t0) / reps / BLOCK;
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			fbcfProcessBlock(combs[0], x, reference, BLOCK);
+
+			for (size_t j = 1; j < N; ++j)
+			{
+				fbcfProcessBlock(combs[j], x, comb, BLOCK);
+				arm_add_f32(reference, comb, reference, BLOCK);
+			}
+		}
+		t1 = benchNow();
+		benchSink = reference[0];
+		double combNs = (t1 - t0) / reps / BLOCK;
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+			fbcfBankProcessBlock(bank, x, y, BLOCK);
+		t1 = benchNow();
+		benchSink = y[0];
+		double bankNs = (t1 - t0) / reps / BLOCK;
+
+		//	Both ran the same number of blocks from silence, so their last blocks should agree.  The error is relative to
+		//	the block's peak
+		float32_t maxError = 0.f;
+		float32_t peak = 0.f;
+		for (size_t i = 0; i < BLOCK; ++i)
+		{
+			maxError = fmaxf(maxError, fabsf(y[i] - reference[i]));
+			peak = fmaxf(peak, fabsf(reference[i]));
+		}
+		maxError /= peak;
+
+		printf("%5zu %14.2f %17.2f %9.2f (%5.1fx) %10.2e\n", N, shiftNs, combNs, bankNs, combNs / bankNs, maxError);
+
+		deleteFBCFBank(bank);
+		for (size_t j = 0; j < N; ++j)
+		{
+			deleteFBCF(combs[j]);
+			deleteFBCF(shiftCombs[j]);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * bench_fdn.c
+ *
+ *  FDN reverberator with 4, 8 and 16 lines against the per-sample reverberator main.c used to run
+ *  (shiftSchroederReverberator): CPU per sample, and the echo density of each impulse response
+ */
+
+#include "bench.h"
+#include "reverb_config.h"
+#include "FeedbackDelayNetwork.h"
+
+
+#define BLOCK 512
+#define IR_LENGTH 36000						//	1.2 s at 30 kHz
+#define NED_WINDOW 600						//	20 ms
+#define NED_DENSE 0.9f
+
+
+//	N = 4 uses main.c's FBCF lengths, the larger networks add mutually prime lengths below them
+static const size_t fdn4Lengths[4] = {1687, 1601, 2053, 2251};
+static const size_t fdn8Lengths[8] = {1009, 1163, 1327, 1481, 1601, 1687, 2053, 2251};
+static const size_t fdn16Lengths[16] = {557, 613, 701, 787, 877, 971, 1063, 1151, 1259, 1361, 1433, 1523, 1601, 1687,
+										2053, 2251};
+
+
+//	Normalized echo density (Abel and Huang) of the NED_WINDOW samples of h centred on sample t: the fraction of them
+//	more than one standard deviation from zero, divided by the fraction expected of Gaussian noise, erfc(1 / sqrt(2)).
+//	Sparse early echoes give a value near 0, a fully diffuse tail gives about 1
+static float32_t benchEchoDensity(const float32_t *h, size_t t)
+{
+	size_t start = (t < NED_WINDOW / 2) ? 0 : t - (NED_WINDOW / 2);
+	double power = 0.0;
+
+	for (size_t i = start; i < start + NED_WINDOW; ++i)
+		power += (double)h[i] * h[i];
+
+	double sigma = sqrt(power / NED_WINDOW);
+	if (sigma == 0.0)
+		return 0.f;
+
+	size_t outside = 0;
+	for (size_t i = start; i < start + NED_WINDOW; ++i)
+	{
+		if (fabs(h[i]) > sigma)
+			++outside;
+	}
+
+	return (float32_t)(((double)outside / NED_WINDOW) / 0.3173105);
+}
+
+
+static void benchPrintRow(const char *name, double nsPerSample, const float32_t *h)
+{
+	printf("%-30s %9.2f", name, nsPerSample);
+
+	size_t times[] = {50, 100, 250, 500};
+	for (size_t k = 0; k < sizeof(times) / sizeof(times[0]); ++k)
+		printf(" %8.2f", benchEchoDensity(h, (size_t)(times[k] * BENCH_REVERB_FS / 1000.f)));
+
+	//	First time (in 5 ms steps) at which the response is as dense as noise
+	size_t step = (size_t)(0.005f * BENCH_REVERB_FS);
+	size_t t = NED_WINDOW / 2;
+
+	while ((t + NED_WINDOW / 2 <= IR_LENGTH) && (benchEchoDensity(h, t) < NED_DENSE))
+		t += step;
+
+	if (t + NED_WINDOW / 2 <= IR_LENGTH)
+		printf(" %10.0f\n", (double)t * 1000.0 / BENCH_REVERB_FS);
+	else
+		printf(" %10s\n", "-");
+}
+
+
+int main(void)
+{
+	static float32_t x[BLOCK];
+	static float32_t y[BLOCK];
+	static float32_t impulse[IR_LENGTH];
+	static float32_t h[IR_LENGTH];
+
+	benchAudio(x, BLOCK, 0, BLOCK);
+	arm_offset_f32(x, -BENCH_ADC_MID_SCALE, x, BLOCK);
+
+	impulse[0] = 1.f;
+
+	int reps = benchRepetitions(BLOCK) / 4;
+
+	//	The FDNs decay at the rate of main.c's combs, averaged over the four of them: a comb of M samples with gain g
+	//	has RT60 = -3M / (fs * log10(g))
+	float32_t rt60 = 0.f;
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+		rt60 += (-3.f * (float32_t)benchFBDelayLengths[i]) / (BENCH_REVERB_FS * log10f(benchFBGains[i]));
+	rt60 /= (float32_t)BENCH_REVERB_NUM_FBCFS;
+
+	printf("reverberators, block %d, RT60 %.2f s, normalized echo density (1 = as dense as noise) at a time\n", BLOCK, rt60);
+	printf("%-30s %9s %8s %8s %8s %8s %10s\n", "engine", "ns/sample", "50 ms", "100 ms", "250 ms", "500 ms",
+		   "dense, ms");
+
+	//	The per-sample reverberator: three APCFs into four parallel FBCFs
+	BenchShiftReverb shiftRev;
+	if (benchCreateShiftReverb(&shiftRev) < 0)
+		return 1;
+
+	double t0 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t i = 0; i < BLOCK; ++i)
+			y[i] = benchShiftReverb(&shiftRev, x[i]);
+	}
+	double t1 = benchNow();
+	benchSink = y[0];
+
+	benchDeleteShiftReverb(&shiftRev);
+	if (benchCreateShiftReverb(&shiftRev) < 0)
+		return 1;
+
+	for (size_t i = 0; i < IR_LENGTH; ++i)
+		h[i] = benchShiftReverb(&shiftRev, impulse[i]);
+
+	benchPrintRow("shiftSchroederReverberator", (t1 - t0) / reps / BLOCK, h);
+	benchDeleteShiftReverb(&shiftRev);
+
+	//	The same reverberator on the block path, for reference
+	SchroederReverbConfig config = benchReverbConfig(DELAY_LINE_FORMAT_F32, 1.f);
+	SchroederReverb *blockRev = createSchroederReverb(&config);
+	if (blockRev == NULL)
+		return 1;
+
+	t0 = benchNow();
+	for (int r = 0; r < reps; ++r)
+		schroederReverbProcessBlock(blockRev, x, y, BLOCK);
+	t1 = benchNow();
+	benchSink = y[0];
+
+	schroederReverbReset(blockRev);
+	for (size_t i = 0; i < IR_LENGTH; i += BLOCK)
+		schroederReverbProcessBlock(blockRev, impulse + i, h + i, (IR_LENGTH - i < BLOCK) ? IR_LENGTH - i : BLOCK);
+
+	benchPrintRow("schroederReverbProcessBlock", (t1 - t0) / reps / BLOCK, h);
+	deleteSchroederReverb(blockRev);
+
+	//	FDNs, no APCF diffusion in front
+	struct
+	{
+		const char *name;
+		size_t N;
+		const size_t *M;
+	}fdns[] = {
+		{"FDN, N = 4 (main.c lengths)", 4, fdn4Lengths},
+		{"FDN, N = 8", 8, fdn8Lengths},
+		{"FDN, N = 16", 16, fdn16Lengths},
+	};
+
+	for (size_t k = 0; k < sizeof(fdns) / sizeof(fdns[0]); ++k)
+	{
+		FDN *f = createFDN(fdns[k].N, fdns[k].M, rt60, BENCH_REVERB_FS);
+		if (f == NULL)
+			return 1;
+
+		t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+			fdnProcessBlock(f, x, y, BLOCK);
+		t1 = benchNow();
+		benchSink = y[0];
+
+		fdnReset(f);
+		fdnProcessBlock(f, impulse, h, IR_LENGTH);
+
+		benchPrintRow(fdns[k].name, (t1 - t0) / reps / BLOCK, h);
+		deleteFDN(f);
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * bench_fir.c
+ *
+ *  FIRFilter's direct and FFT kernels against the shift-register filterAudioBlock() main.c used to run, for lowpass
+ *  filters of 9 to 2047 taps, across the point where FIR_FILTER_AUTO switches to the FFT
+ */
+
+#include "bench.h"
+#include "fir_config.h"
+#include "FIRFilter.h"
+#include <math.h>
+
+
+#define MAX_TAPS 2047
+#define NUM_BLOCKS 16
+
+
+//	Time per sample of one FIRFilter mode over the NUM_BLOCKS blocks of x, and its largest difference from reference
+static double benchFIRFilter(const float32_t *h, size_t numTaps, FIRFilterMode mode, const float32_t *x,
+							 const float32_t *reference, float32_t *y, int reps, float32_t *maxError)
+{
+	FIRFilter *f = createFIRFilterWithMode(h, numTaps, BENCH_FIR_BLOCK_SIZE, mode);
+	if (f == NULL)
+		return -1.0;
+
+	double t0 = benchNow();
+	for (int r = 0; r < reps; ++r)
+	{
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			firFilterProcessBlock(f, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+	}
+	double t1 = benchNow();
+	benchSink = y[0];
+
+	//	Same input from a clean history, so that the outputs line up with the reference's
+	firFilterReset(f);
+	for (size_t b = 0; b < NUM_BLOCKS; ++b)
+		firFilterProcessBlock(f, x + (b * BENCH_FIR_BLOCK_SIZE), y + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE);
+
+	*maxError = 0.f;
+	for (size_t i = 0; i < NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE; ++i)
+	{
+		float32_t e = fabsf(y[i] - reference[i]);
+		if (e > *maxError)
+			*maxError = e;
+	}
+
+	deleteFIRFilter(f);
+
+	return (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+}
+
+
+int main(void)
+{
+	static float32_t x[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t reference[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	static float32_t y[NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE];
+	float32_t h[MAX_TAPS];
+
+	benchNoise(x, NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE, 1);
+
+	static const size_t taps[] = {9, 15, 31, 63, 127, 255, 511, 1023, 2047};
+
+	printf("FIR lowpass, fc %.0f Hz at fs %.0f Hz, Blackman window, block %d, ns/sample (speedup over filterAudioBlock)\n",
+		   BENCH_FIR_FC, BENCH_FIR_FS, BENCH_FIR_BLOCK_SIZE);
+	printf("%5s %16s %18s %18s %18s %6s %10s\n", "taps", "filterAudioBlock", "direct", "FFT", "AUTO", "picks",
+		   "max error");
+
+	for (size_t k = 0; k < sizeof(taps) / sizeof(taps[0]); ++k)
+	{
+		size_t numTaps = taps[k];
+
+		if (fir_calculateWindowedLPFCoefficients(BENCH_FIR_FC, BENCH_FIR_FS, numTaps, FIR_WINDOW_BLACKMAN, 0.f, h) < 0)
+			return 1;
+
+		int reps = benchRepetitions(NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE * numTaps / 16);
+
+		//	The shift register moves all numTaps samples for every output, so it is timed over fewer repetitions
+		BenchShiftFIR shift;
+		if (benchCreateShiftFIR(&shift, numTaps) < 0)
+			return 1;
+
+		double t0 = benchNow();
+		for (int r = 0; r < reps; ++r)
+		{
+			for (size_t b = 0; b < NUM_BLOCKS; ++b)
+				benchFilterAudioBlock(&shift, x + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE, h,
+									  y + (b * BENCH_FIR_BLOCK_SIZE));
+		}
+		double t1 = benchNow();
+		benchSink = y[0];
+
+		double shiftNs = (t1 - t0) / reps / (NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		benchResetShiftFIR(&shift);
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+			benchFilterAudioBlock(&shift, x + (b * BENCH_FIR_BLOCK_SIZE), BENCH_FIR_BLOCK_SIZE, h,
+								  reference + (b * BENCH_FIR_BLOCK_SIZE));
+		benchDeleteShiftFIR(&shift);
+
+		//	The kernels are fast enough for the full count
+		reps = benchRepetitions(NUM_BLOCKS * BENCH_FIR_BLOCK_SIZE);
+
+		float32_t directError, fftError, autoError;
+		double directNs = benchFIRFilter(h, numTaps, FIR_FILTER_DIRECT, x, reference, y, reps, &directError);
+		double fftNs = benchFIRFilter(h, numTaps, FIR_FILTER_FFT, x, reference, y, reps, &fftError);
+		double autoNs = benchFIRFilter(h, numTaps, FIR_FILTER_AUTO, x, reference, y, reps, &autoError);
+		if ((directNs < 0.0) || (fftNs < 0.0) || (autoNs < 0.0))
+			return 1;
+
+		FIRFilter *f = createFIRFilter(h, numTaps, BENCH_FIR_BLOCK_SIZE);
+		if (f == NULL)
+			return 1;
+		const char *picks = (f->mode == FIR_FILTER_FFT) ? "FFT" : "direct";
+		deleteFIRFilter(f);
+
+		float32_t maxError = fmaxf(directError, fmaxf(fftError, autoError));
+
+		printf("%5zu %16.2f %9.2f (%5.1fx) %9.2f (%5.1fx) %9.2f (%5.1fx) %6s %10.2e\n", numTaps, shiftNs,
+			   directNs, shiftNs / directNs, fftNs, shiftNs / fftNs, autoNs, shiftNs / autoNs, picks, maxError);
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * bench_fractional_delay.c
+ *
+ *  delayLineProcessFractionalBlock() against delayLineShift() plus delayLineReadFractional() per sample, for each
+ *  interpolator: agreement between the two, accuracy on a sine, and ns/sample with a swept delay
+ */
+
+#include "bench.h"
+#include "DelayLine.h"
+
+
+#define BLOCK 512
+#define SWEEP_M 1024
+
+
+static const char *interpNames[] = {"linear", "allpass", "Hermite"};
+
+
+//	Largest difference between the block and per-sample paths over random delays covering the whole line, for a line
+//	of length M fed blocks of varying length
+static float32_t agreement(size_t M, DelayLineInterp interp)
+{
+	static float32_t x[BLOCK];
+	static float32_t delay[BLOCK];
+	static float32_t y[BLOCK];
+	static float32_t yRef[BLOCK];
+
+	DelayLine *a = createDelayLine(M);
+	DelayLine *b = createDelayLine(M);
+	float32_t stateA = 0.f;
+	float32_t stateB = 0.f;
+	float32_t worst = 0.f;
+
+	srand((unsigned int)M);
+
+	for (int block = 0; block < 40; ++block)
+	{
+		size_t n = 1 + ((size_t)rand() % BLOCK);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			x[i] = ((float32_t)rand() / (float32_t)RAND_MAX) - 0.5f;
+			delay[i] = (float32_t)rand() / (float32_t)RAND_MAX * (float32_t)(M + 1);
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			float32_t delayOut;
+			delayLineShift(a, x[i], &delayOut);
+			delayLineReadFractional(a, delay[i], interp, &stateA, &yRef[i]);
+		}
+
+		//	In place, to cover x and y pointing to the same buffer
+		memcpy(y, x, sizeof(float32_t) * n);
+		delayLineProcessFractionalBlock(b, y, delay, y, n, interp, &stateB);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			float32_t diff = fabsf(y[i] - yRef[i]);
+			if (diff > worst)
+				worst = diff;
+		}
+	}
+
+	deleteDelayLine(a);
+	deleteDelayLine(b);
+
+	return worst;
+}
+
+
+int main(void)
+{
+	static float32_t x[BLOCK];
+	static float32_t delay[BLOCK];
+	static float32_t y[BLOCK];
+	size_t lengths[] = {4, 5, 17, 31, 32, 33, 100, 1024};
+
+	printf("fractional delay, block path against per-sample path, random delays over the whole line\n");
+	printf("%-8s", "M");
+	for (int k = 0; k < 3; ++k)
+		printf(" %12s", interpNames[k]);
+	printf("\n");
+
+	for (size_t m = 0; m < sizeof(lengths) / sizeof(lengths[0]); ++m)
+	{
+		printf("%-8zu", lengths[m]);
+		for (int k = 0; k < 3; ++k)
+			printf(" %12.2g", agreement(lengths[m], (DelayLineInterp)k));
+		printf("\n");
+	}
+
+	printf("\nM = %d, block %d, delay swept 100 +/- 80 samples\n", SWEEP_M, BLOCK);
+	printf("%-8s %14s %14s %20s\n", "interp", "block ns", "per-sample ns", "max error on sine");
+
+	for (int k = 0; k < 3; ++k)
+	{
+		DelayLineInterp interp = (DelayLineInterp)k;
+		DelayLine *a = createDelayLine(SWEEP_M);
+		DelayLine *b = createDelayLine(SWEEP_M);
+		float32_t stateA = 0.f;
+		float32_t stateB = 0.f;
+		int reps = 4000;
+		size_t t = 0;
+
+		double blockTime = 0.0;
+		double sampleTime = 0.0;
+		float32_t worst = 0.f;
+
+		for (int rep = 0; rep < reps; ++rep)
+		{
+			for (size_t i = 0; i < BLOCK; ++i, ++t)
+			{
+				x[i] = (float32_t)sin(0.05 * (double)t);
+				delay[i] = 100.f + (80.f * sinf(0.001f * (float32_t)t));
+			}
+
+			double t0 = benchNow();
+			delayLineProcessFractionalBlock(b, x, delay, y, BLOCK, interp, &stateB);
+			double t1 = benchNow();
+
+			//	The interpolated sine against the exact one, once the line has filled
+			if (rep > 4)
+			{
+				for (size_t i = 0; i < BLOCK; ++i)
+				{
+					float32_t exact = (float32_t)sin(0.05 * ((double)(t - BLOCK + i) - (double)delay[i]));
+					float32_t error = fabsf(y[i] - exact);
+					if (error > worst)
+						worst = error;
+				}
+			}
+
+			double t2 = benchNow();
+			for (size_t i = 0; i < BLOCK; ++i)
+			{
+				float32_t delayOut;
+				delayLineShift(a, x[i], &delayOut);
+				delayLineReadFractional(a, delay[i], interp, &stateA, &y[i]);
+			}
+			double t3 = benchNow();
+
+			blockTime += t1 - t0;
+			sampleTime += t3 - t2;
+		}
+
+		benchSink = y[0];
+		printf("%-8s %14.2f %14.2f %20.2g\n", interpNames[k], blockTime / reps / BLOCK, sampleTime / reps / BLOCK, worst);
+
+		deleteDelayLine(a);
+		deleteDelayLine(b);
+	}
+
+	return 0;
+}
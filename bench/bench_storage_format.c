@@ -0,0 +1,94 @@
+/*
+ * bench_storage_format.c
+ *
+ *  Q15 and half-float FBCF delay line storage against float storage, running main.c's reverberator: CPU per sample,
+ *  RAM, and the SNR of the output with float storage as the reference
+ */
+
+#include "bench.h"
+#include "reverb_config.h"
+
+
+#define NUM_BLOCKS 60
+#define ACTIVE_BLOCKS 40
+
+
+typedef struct
+{
+	const char *name;
+	DelayLineFormat format;
+	float32_t fullScale;
+}StorageCase;
+
+
+int main(void)
+{
+	static float32_t x[BENCH_REVERB_BLOCK_SIZE];
+	static float32_t reference[BENCH_REVERB_BLOCK_SIZE];
+	static float32_t y[BENCH_REVERB_BLOCK_SIZE];
+
+	//	main.c uses FB_FULL_SCALE 32768 for Q15, the smaller ones show the trade against headroom
+	StorageCase cases[] = {
+		{"F32", DELAY_LINE_FORMAT_F32, 1.f},
+		{"Q15 fullScale 32768", DELAY_LINE_FORMAT_Q15, 32768.f},
+		{"Q15 fullScale 16384", DELAY_LINE_FORMAT_Q15, 16384.f},
+		{"F16", DELAY_LINE_FORMAT_F16, 1.f},
+	};
+	size_t numCases = sizeof(cases) / sizeof(cases[0]);
+
+	SchroederReverbConfig referenceConfig = benchReverbConfig(DELAY_LINE_FORMAT_F32, 1.f);
+
+	printf("Schroeder reverberator (main.c config), FBCF storage format\n");
+	printf("%-22s %12s %12s %10s\n", "storage", "arena bytes", "ns/sample", "SNR dB");
+
+	for (size_t k = 0; k < numCases; ++k)
+	{
+		SchroederReverbConfig config = benchReverbConfig(cases[k].format, cases[k].fullScale);
+		SchroederReverb *ref = createSchroederReverb(&referenceConfig);
+		SchroederReverb *r = createSchroederReverb(&config);
+		if ((ref == NULL) || (r == NULL))
+			return 1;
+
+		//	Error power of the output against float storage, over the signal and its decaying tail.  The signal power is
+		//	the reference's variance, so that the mid-scale level the FBCFs amplify doesn't count as signal
+		double sum = 0.0;
+		double sumSquares = 0.0;
+		double error = 0.0;
+
+		for (size_t b = 0; b < NUM_BLOCKS; ++b)
+		{
+			benchAudio(x, BENCH_REVERB_BLOCK_SIZE, b * BENCH_REVERB_BLOCK_SIZE, ACTIVE_BLOCKS * BENCH_REVERB_BLOCK_SIZE);
+			schroederReverbProcessBlock(ref, x, reference, BENCH_REVERB_BLOCK_SIZE);
+			schroederReverbProcessBlock(r, x, y, BENCH_REVERB_BLOCK_SIZE);
+
+			for (size_t i = 0; i < BENCH_REVERB_BLOCK_SIZE; ++i)
+			{
+				double e = (double)y[i] - (double)reference[i];
+
+				sum += reference[i];
+				sumSquares += (double)reference[i] * reference[i];
+				error += e * e;
+			}
+		}
+
+		int reps = 200;
+		benchAudio(x, BENCH_REVERB_BLOCK_SIZE, 0, BENCH_REVERB_BLOCK_SIZE);
+
+		double t0 = benchNow();
+		for (int rep = 0; rep < reps; ++rep)
+			schroederReverbProcessBlock(r, x, y, BENCH_REVERB_BLOCK_SIZE);
+		double t1 = benchNow();
+
+		benchSink = y[0];
+
+		double count = (double)(NUM_BLOCKS * BENCH_REVERB_BLOCK_SIZE);
+		double signal = sumSquares - (sum * sum / count);
+		double snr = (error > 0.0) ? (10.0 * log10(signal / error)) : INFINITY;
+		printf("%-22s %12zu %12.2f %10.1f\n", cases[k].name, schroederReverbArenaSize(&config), (t1 - t0) / reps / BENCH_REVERB_BLOCK_SIZE, snr);
+
+		deleteSchroederReverb(ref);
+		deleteSchroederReverb(r);
+	}
+
+	return 0;
+}
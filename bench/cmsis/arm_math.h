@@ -0,0 +1,312 @@
+/*
+ * arm_math.h
+ *
+ *  Host stand-in for the parts of CMSIS-DSP the examples use, so that their sources can be built and timed on a
+ *  desktop machine.  Only the bench programs include it; the examples themselves are always built against the
+ *  real CMSIS-DSP in Simplicity Studio
+ */
+
+#ifndef BENCH_ARM_MATH_H_
+#define BENCH_ARM_MATH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+typedef float float32_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+
+#define PI 3.14159265358979f
+
+//	Full barrier, the closest host equivalent of the Cortex-M data memory barrier
+#define __DMB() __sync_synchronize()
+
+typedef enum
+{
+	ARM_MATH_SUCCESS = 0,
+	ARM_MATH_ARGUMENT_ERROR = -1
+}arm_status;
+
+
+static inline void arm_copy_f32(const float32_t *src, float32_t *dst, uint32_t n)
+{
+	memmove(dst, src, n * sizeof(float32_t));
+}
+
+static inline void arm_fill_f32(float32_t value, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+		dst[i] = value;
+}
+
+static inline void arm_scale_f32(const float32_t *src, float32_t scale, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+		dst[i] = src[i] * scale;
+}
+
+static inline void arm_offset_f32(const float32_t *src, float32_t offset, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+		dst[i] = src[i] + offset;
+}
+
+static inline void arm_add_f32(const float32_t *a, const float32_t *b, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+		dst[i] = a[i] + b[i];
+}
+
+//	Four partial sums, like the unrolled CMSIS loop
+static inline void arm_dot_prod_f32(const float32_t *a, const float32_t *b, uint32_t n, float32_t *result)
+{
+	float32_t s0 = 0.f, s1 = 0.f, s2 = 0.f, s3 = 0.f;
+	uint32_t i = 0;
+
+	for (; i + 4 <= n; i += 4)
+	{
+		s0 += a[i] * b[i];
+		s1 += a[i + 1] * b[i + 1];
+		s2 += a[i + 2] * b[i + 2];
+		s3 += a[i + 3] * b[i + 3];
+	}
+
+	for (; i < n; ++i)
+		s0 += a[i] * b[i];
+
+	*result = (s0 + s1) + (s2 + s3);
+}
+
+static inline void arm_max_f32(const float32_t *src, uint32_t n, float32_t *result, uint32_t *index)
+{
+	uint32_t k = 0;
+
+	for (uint32_t i = 1; i < n; ++i)
+	{
+		if (src[i] > src[k])
+			k = i;
+	}
+
+	*result = src[k];
+	*index = k;
+}
+
+static inline void arm_min_f32(const float32_t *src, uint32_t n, float32_t *result, uint32_t *index)
+{
+	uint32_t k = 0;
+
+	for (uint32_t i = 1; i < n; ++i)
+	{
+		if (src[i] < src[k])
+			k = i;
+	}
+
+	*result = src[k];
+	*index = k;
+}
+
+static inline void arm_cmplx_mult_cmplx_f32(const float32_t *a, const float32_t *b, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		float32_t ar = a[2 * i], ai = a[(2 * i) + 1];
+		float32_t br = b[2 * i], bi = b[(2 * i) + 1];
+
+		dst[2 * i] = (ar * br) - (ai * bi);
+		dst[(2 * i) + 1] = (ar * bi) + (ai * br);
+	}
+}
+
+static inline float32_t arm_sin_f32(float32_t x)
+{
+	return sinf(x);
+}
+
+static inline float32_t arm_cos_f32(float32_t x)
+{
+	return cosf(x);
+}
+
+static inline arm_status arm_sqrt_f32(float32_t x, float32_t *result)
+{
+	if (x < 0.f)
+	{
+		*result = 0.f;
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+
+	*result = sqrtf(x);
+
+	return ARM_MATH_SUCCESS;
+}
+
+static inline void arm_float_to_q15(const float32_t *src, q15_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		float32_t v = src[i] * 32768.f;
+		v = (v > 32767.f) ? 32767.f : ((v < -32768.f) ? -32768.f : v);
+		dst[i] = (q15_t)lrintf(v);
+	}
+}
+
+static inline void arm_q15_to_float(const q15_t *src, float32_t *dst, uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+		dst[i] = (float32_t)src[i] / 32768.f;
+}
+
+
+//	Real FFT with the same packed output format as arm_rfft_fast_f32: {X[0], X[N/2], Re X[1], Im X[1], ...}.
+//	An N/2 point complex radix-2 FFT plus the usual split step.  Slower than CMSIS, but the same amount of work per
+//	call, which is what the benchmarks compare
+typedef struct
+{
+	uint16_t fftLenRFFT;
+	float32_t *twiddle;			//	e^(-2 pi i k / N), k < N / 2
+	float32_t *cfftTwiddle;		//	e^(-2 pi i k / (N / 2)), k < N / 4
+	float32_t *work;
+}arm_rfft_fast_instance_f32;
+
+static inline arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 *S, uint16_t N)
+{
+	if ((N < 32) || (N > 4096) || ((N & (N - 1)) != 0))
+		return ARM_MATH_ARGUMENT_ERROR;
+
+	S->fftLenRFFT = N;
+	S->twiddle = (float32_t *)malloc(sizeof(float32_t) * N);
+	S->cfftTwiddle = (float32_t *)malloc(sizeof(float32_t) * N);
+	S->work = (float32_t *)malloc(sizeof(float32_t) * N);
+
+	for (int k = 0; k < N / 2; ++k)
+	{
+		S->twiddle[2 * k] = (float32_t)cos(2 * M_PI * k / N);
+		S->twiddle[(2 * k) + 1] = (float32_t)-sin(2 * M_PI * k / N);
+	}
+
+	for (int k = 0; k < N / 4; ++k)
+	{
+		S->cfftTwiddle[2 * k] = (float32_t)cos(2 * M_PI * k / (N / 2));
+		S->cfftTwiddle[(2 * k) + 1] = (float32_t)-sin(2 * M_PI * k / (N / 2));
+	}
+
+	return ARM_MATH_SUCCESS;
+}
+
+static inline void benchComplexFFT(float32_t *z, int M, const float32_t *twiddle, int inverse)
+{
+	for (int i = 1, j = 0; i < M; ++i)
+	{
+		int bit = M >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+
+		j ^= bit;
+
+		if (i < j)
+		{
+			float32_t t = z[2 * i]; z[2 * i] = z[2 * j]; z[2 * j] = t;
+			t = z[(2 * i) + 1]; z[(2 * i) + 1] = z[(2 * j) + 1]; z[(2 * j) + 1] = t;
+		}
+	}
+
+	for (int len = 2; len <= M; len <<= 1)
+	{
+		int step = M / len;
+
+		for (int i = 0; i < M; i += len)
+		{
+			for (int k = 0; k < len / 2; ++k)
+			{
+				float32_t wr = twiddle[2 * k * step];
+				float32_t wi = inverse ? -twiddle[(2 * k * step) + 1] : twiddle[(2 * k * step) + 1];
+				float32_t *a = z + (2 * (i + k));
+				float32_t *b = z + (2 * (i + k + (len / 2)));
+				float32_t br = (b[0] * wr) - (b[1] * wi);
+				float32_t bi = (b[0] * wi) + (b[1] * wr);
+
+				b[0] = a[0] - br;
+				b[1] = a[1] - bi;
+				a[0] += br;
+				a[1] += bi;
+			}
+		}
+	}
+}
+
+static inline void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *out, uint8_t inverse)
+{
+	int N = S->fftLenRFFT;
+	int M = N / 2;
+	float32_t *z = S->work;
+
+	if (!inverse)
+	{
+		memcpy(z, p, sizeof(float32_t) * N);
+		benchComplexFFT(z, M, S->cfftTwiddle, 0);
+
+		for (int k = 0; k <= M / 2; ++k)
+		{
+			int k2 = (M - k) % M;
+			float32_t er = (z[2 * k] + z[2 * k2]) / 2, ei = (z[(2 * k) + 1] - z[(2 * k2) + 1]) / 2;
+			float32_t dr = (z[2 * k] - z[2 * k2]) / 2, di = (z[(2 * k) + 1] + z[(2 * k2) + 1]) / 2;
+			float32_t wr = S->twiddle[2 * k], wi = S->twiddle[(2 * k) + 1];
+			float32_t tr = (di * wr) + (dr * wi);
+			float32_t ti = (di * wi) - (dr * wr);
+
+			if (k == 0)
+			{
+				out[0] = er + tr;
+				out[1] = er - tr;
+			}
+			else
+			{
+				out[2 * k] = er + tr;
+				out[(2 * k) + 1] = ei + ti;
+
+				if (k != M - k)
+				{
+					out[2 * (M - k)] = er - tr;
+					out[(2 * (M - k)) + 1] = ti - ei;
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int k = 0; k < M; ++k)
+		{
+			float32_t xr, xi, cr, ci;
+
+			if (k == 0)
+			{
+				xr = p[0]; xi = 0.f; cr = p[1]; ci = 0.f;
+			}
+			else
+			{
+				xr = p[2 * k]; xi = p[(2 * k) + 1]; cr = p[2 * (M - k)]; ci = -p[(2 * (M - k)) + 1];
+			}
+
+			float32_t er = (xr + cr) / 2, ei = (xi + ci) / 2, dr = (xr - cr) / 2, di = (xi - ci) / 2;
+			float32_t wr = S->twiddle[2 * k], wi = -S->twiddle[(2 * k) + 1];
+			float32_t orr = (dr * wr) - (di * wi), oi = (dr * wi) + (di * wr);
+
+			z[2 * k] = er - oi;
+			z[(2 * k) + 1] = ei + orr;
+		}
+
+		benchComplexFFT(z, M, S->cfftTwiddle, 1);
+
+		for (int i = 0; i < N; ++i)
+			out[i] = z[i] / M;
+	}
+}
+
+
+#endif /* BENCH_ARM_MATH_H_ */
@@ -0,0 +1,85 @@
+/*
+ * fir_config.h
+ *
+ *  The lowpass fir_lowpass_filter/src/main.c runs, and the filter it ran before FIRFilter, for the benchmarks that
+ *  time it
+ */
+
+#ifndef BENCH_FIR_CONFIG_H_
+#define BENCH_FIR_CONFIG_H_
+
+#include "FIRDesign.h"
+#include <string.h>
+
+
+#define BENCH_FIR_FS 40000.f
+#define BENCH_FIR_FC 1000.f
+#define BENCH_FIR_BLOCK_SIZE 512
+
+
+//	filterAudioBlock() as main.c had it before FIRFilter: a shift register v of numTaps input samples that is moved up
+//	by one for every sample, then a dot product with h.  main.c kept v in a global, here it is the struct's
+typedef struct
+{
+	float32_t *v;
+	size_t numTaps;
+}BenchShiftFIR;
+
+
+static inline int benchCreateShiftFIR(BenchShiftFIR *f, size_t numTaps)
+{
+	f->v = calloc(numTaps, sizeof(float32_t));
+	f->numTaps = numTaps;
+
+	return (f->v == NULL) ? -1 : 0;
+}
+
+
+static inline void benchDeleteShiftFIR(BenchShiftFIR *f)
+{
+	free(f->v);
+	f->v = NULL;
+}
+
+
+static inline void benchResetShiftFIR(BenchShiftFIR *f)
+{
+	memset(f->v, 0, f->numTaps * sizeof(float32_t));
+}
+
+
+static inline int benchFilterAudioBlock(BenchShiftFIR *f, const float32_t *x, size_t bufferSize, const float32_t *h,
+										float32_t *y)
+{
+	float32_t *v = f->v;
+	size_t numFilterCoefficients = f->numTaps;
+
+	if ((x == NULL) || (y == NULL))
+		return -1;
+
+	if ((bufferSize == 0) || (numFilterCoefficients == 0))
+	{
+		arm_fill_f32(0.f, y, bufferSize);
+		return 0;
+	}
+
+	for (size_t i = 0; i < bufferSize; ++i)
+	{
+		for (size_t j = numFilterCoefficients - 1; j > 0; --j)
+			v[j] = v[j-1];
+
+		v[0] = x[i];
+
+		float32_t output = 0.f;
+
+		for (size_t j = 0; j < numFilterCoefficients; ++j)
+			output += h[j] * v[j];
+
+		y[i] = output;
+	}
+
+	return 0;
+}
+
+
+#endif /* BENCH_FIR_CONFIG_H_ */
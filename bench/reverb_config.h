@@ -0,0 +1,126 @@
+/*
+ * reverb_config.h
+ *
+ *  The reverberator configuration schroeder_reverberator/src/main.c runs, for the benchmarks that time it
+ */
+
+#ifndef BENCH_REVERB_CONFIG_H_
+#define BENCH_REVERB_CONFIG_H_
+
+#include "SchroederReverb.h"
+#include "CombFilter.h"
+
+
+#define BENCH_REVERB_FS 30000.f
+#define BENCH_REVERB_BLOCK_SIZE 2048
+#define BENCH_REVERB_NUM_APCFS 3
+#define BENCH_REVERB_NUM_FBCFS 4
+
+//	main.c's input is raw 12-bit ADC codes, which idle at mid-scale
+#define BENCH_ADC_MID_SCALE 2048.f
+
+static const size_t benchAPDelayLengths[BENCH_REVERB_NUM_APCFS] = {347, 113, 37};
+static const size_t benchFBDelayLengths[BENCH_REVERB_NUM_FBCFS] = {1687, 1601, 2053, 2251};
+static const float32_t benchFBGains[BENCH_REVERB_NUM_FBCFS] = {0.773f, 0.802f, 0.753f, 0.733f};
+
+
+//	main.c's config with the given FBCF storage, and the silence gate off so that every block is processed
+static inline SchroederReverbConfig benchReverbConfig(DelayLineFormat format, float32_t fullScale)
+{
+	SchroederReverbConfig c;
+
+	c.numAPCFs = BENCH_REVERB_NUM_APCFS;
+	c.apDelayLengths = benchAPDelayLengths;
+	c.apGain = 0.7f;
+	c.numFBCFs = BENCH_REVERB_NUM_FBCFS;
+	c.fbDelayLengths = benchFBDelayLengths;
+	c.fbGains = benchFBGains;
+	c.numChannels = 1;
+	c.mixMatrix = NULL;
+	c.maxBlockSize = BENCH_REVERB_BLOCK_SIZE;
+	c.fbFormat = format;
+	c.fbFullScale = fullScale;
+	c.maxRoomSize = 1.f;
+	c.fs = BENCH_REVERB_FS;
+	c.silenceThreshold = 0.f;
+
+	return c;
+}
+
+
+//	ADC-like test signal: two tones and some noise around mid-scale for the first active samples, then mid-scale
+static inline void benchAudio(float32_t *x, size_t n, size_t start, size_t active)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		size_t t = start + i;
+		float32_t v = 0.f;
+
+		if (t < active)
+			v = (1200.f * sinf((float32_t)t * 0.05f)) + (600.f * sinf((float32_t)t * 0.0137f)) + (200.f * sinf((float32_t)t * 1.9f));
+
+		x[i] = BENCH_ADC_MID_SCALE + v;
+	}
+}
+
+
+//	The per-sample reverberator main.c ran before SchroederReverb: shiftSchroederReverberator() over APCFs made of an
+//	FFCF and an FBCF each, then the FBCFs summed
+typedef struct
+{
+	APCF *ap[BENCH_REVERB_NUM_APCFS];
+	FBCF *fb[BENCH_REVERB_NUM_FBCFS];
+}BenchShiftReverb;
+
+
+static inline int benchCreateShiftReverb(BenchShiftReverb *r)
+{
+	for (size_t i = 0; i < BENCH_REVERB_NUM_APCFS; ++i)
+	{
+		r->ap[i] = createAPCF(benchAPDelayLengths[i], -0.7f, 0.7f);
+		if (r->ap[i] == NULL)
+			return -1;
+	}
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+	{
+		r->fb[i] = createFBCF(benchFBDelayLengths[i], 1.f, -benchFBGains[i]);
+		if (r->fb[i] == NULL)
+			return -1;
+	}
+
+	return 0;
+}
+
+
+static inline void benchDeleteShiftReverb(BenchShiftReverb *r)
+{
+	for (size_t i = 0; i < BENCH_REVERB_NUM_APCFS; ++i)
+		deleteAPCF(r->ap[i]);
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+		deleteFBCF(r->fb[i]);
+}
+
+
+static inline float32_t benchShiftReverb(BenchShiftReverb *r, float32_t x)
+{
+	float32_t filterInput = x;
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_APCFS; ++i)
+		apcfShift(r->ap[i], filterInput, &filterInput);
+
+	float32_t sum = 0.f;
+
+	for (size_t i = 0; i < BENCH_REVERB_NUM_FBCFS; ++i)
+	{
+		float32_t fbcfOut = 0.f;
+		fbcfShift(r->fb[i], filterInput, &fbcfOut);
+		sum += fbcfOut;
+	}
+
+	return sum;
+}
+
+
+#endif /* BENCH_REVERB_CONFIG_H_ */
@@ -64,6 +64,7 @@ APCF *createAPCF(size_t M, float32_t b0, float32_t am)
 	a->fb = createFBCF(M, 1, am);
 	if (a->fb == NULL)
 	{
+		deleteFFCF(a->ff);
 		free(a);
 		return NULL;
 	}
@@ -163,3 +164,118 @@ int apcfShift(APCF *a, float32_t x, float32_t *y)
 }
 
 
+//	Process a block of n samples through the FFCF.  The block is split at the delay line's wrap point and the
+//	delayed samples of each piece are read straight out of the delay line buffer.  x and y may point to the same buffer
+int ffcfProcessBlock(FFCF *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DelayLine *d = f->M;
+	if (d == NULL) return -1;
+
+	//	Pass-through delay line (M = 0)
+	if (d->M == 0)
+	{
+		arm_scale_f32((float32_t *)x, f->b0 + f->bm, y, n);
+		return 0;
+	}
+
+	if (d->currentPtr >= d->M) return -1;
+
+	while (n > 0)
+	{
+		size_t count = d->M - d->currentPtr;
+		if (count > n)
+			count = n;
+
+		float32_t *line = &d->buffer[d->currentPtr];
+
+		//	y = (b0 * x) + (bm * x[n - M]), then the input replaces the delayed samples
+		if (x != y)
+		{
+			arm_scale_f32(line, f->bm, line, count);
+			arm_scale_f32((float32_t *)x, f->b0, y, count);
+			arm_add_f32(y, line, y, count);
+			arm_copy_f32((float32_t *)x, line, count);
+		}
+
+		//	In-place, the input has to be saved into the delay line before it is overwritten
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				float32_t delayOut = line[i];
+				line[i] = y[i];
+				y[i] = (line[i] * f->b0) + (delayOut * f->bm);
+			}
+		}
+
+		d->currentPtr += count;
+		if (d->currentPtr >= d->M)
+			d->currentPtr = 0;
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+//	Process a block of n samples through the FBCF.  Each piece of the block is at most M samples long, so every
+//	feedback sample it needs was written before the piece started and the recurrence v = x + (am * v[n - M]) turns
+//	into a plain scale-and-add over the delay line buffer.  x and y may point to the same buffer
+int fbcfProcessBlock(FBCF *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DelayLine *d = f->M;
+	if (d == NULL) return -1;
+
+	//	Pass-through delay line (M = 0), same as fbcfShift()
+	if (d->M == 0)
+	{
+		arm_scale_f32((float32_t *)x, f->b0, y, n);
+		return 0;
+	}
+
+	if (d->currentPtr >= d->M) return -1;
+
+	while (n > 0)
+	{
+		size_t count = d->M - d->currentPtr;
+		if (count > n)
+			count = n;
+
+		float32_t *line = &d->buffer[d->currentPtr];
+
+		arm_scale_f32(line, f->am, line, count);
+		arm_add_f32(line, (float32_t *)x, line, count);
+		arm_scale_f32(line, f->b0, y, count);
+
+		d->currentPtr += count;
+		if (d->currentPtr >= d->M)
+			d->currentPtr = 0;
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+int apcfProcessBlock(APCF *a, const float32_t *x, float32_t *y, size_t n)
+{
+	if (a == NULL) return -1;
+
+	int status = ffcfProcessBlock(a->ff, x, y, n);
+	if (status < 0)
+		return -1;
+
+	return fbcfProcessBlock(a->fb, y, y, n);
+}
+
+
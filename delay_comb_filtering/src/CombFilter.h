@@ -53,6 +53,10 @@ int 		ffcfShift(FFCF *f, float32_t x, float32_t *y);
 int 		fbcfShift(FBCF *f, float32_t x, float32_t *y);
 int 		apcfShift(APCF *a, float32_t x, float32_t *y);
 
+int 		ffcfProcessBlock(FFCF *f, const float32_t *x, float32_t *y, size_t n);
+int 		fbcfProcessBlock(FBCF *f, const float32_t *x, float32_t *y, size_t n);
+int 		apcfProcessBlock(APCF *a, const float32_t *x, float32_t *y, size_t n);
+
 
 
 #endif /* SRC_COMBFILTER_H_ */
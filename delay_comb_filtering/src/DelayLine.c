@@ -90,3 +90,60 @@ int delayLinePeek(DelayLine *d, float32_t *y)
 }
 
 
+//	Shift a block of n samples through the delay line.  The block is split at most twice around the wrap point
+//	(more often only if n > M) so that each piece is moved with bulk copies instead of one delayLineShift() per sample.
+//	x and y may point to the same buffer
+int delayLineProcessBlock(DelayLine *d, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((d == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	//	Pass-through case (M = 0)
+	if (d->M == 0)
+	{
+		if (x != y)
+			arm_copy_f32((float32_t *)x, y, n);
+
+		return 0;
+	}
+
+	if (d->currentPtr >= d->M) return -1;
+
+	while (n > 0)
+	{
+		//	Number of samples until the pointer wraps
+		size_t count = d->M - d->currentPtr;
+		if (count > n)
+			count = n;
+
+		float32_t *line = &d->buffer[d->currentPtr];
+
+		if (x != y)
+		{
+			arm_copy_f32(line, y, count);
+			arm_copy_f32((float32_t *)x, line, count);
+		}
+
+		//	In-place, the delayed samples and the input have to be swapped
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				float32_t delayOut = line[i];
+				line[i] = y[i];
+				y[i] = delayOut;
+			}
+		}
+
+		d->currentPtr += count;
+		if (d->currentPtr >= d->M)
+			d->currentPtr = 0;
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
@@ -23,6 +23,7 @@ DelayLine		*createDelayLine(size_t M);
 void 			deleteDelayLine(DelayLine *d);
 int 			delayLineShift(DelayLine *d, float32_t x, float32_t *y);
 int 			delayLinePeek(DelayLine *d, float32_t *y);
+int 			delayLineProcessBlock(DelayLine *d, const float32_t *x, float32_t *y, size_t n);
 
 
 #endif /* SRC_DELAYLINE_H_ */
@@ -0,0 +1,180 @@
+/*
+ * SilenceGate.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "SilenceGate.h"
+
+
+//	threshold is the output level that counts as silence, e.g. 1 LSB of the DAC
+int silenceGateInit(SilenceGate *g, float32_t threshold, size_t minTail, float32_t decayTime, float32_t maxGain)
+{
+	if (g == NULL) return -1;
+	if (threshold <= 0.f) return -1;
+
+	g->threshold = threshold;
+	g->dc = 0.f;
+	g->dcValid = 0;
+	silenceGateSetDecay(g, minTail, decayTime, maxGain);
+	silenceGateReset(g);
+
+	return 0;
+}
+
+
+//	Change the tail parameters, e.g. when the filter's feedback gains change
+void silenceGateSetDecay(SilenceGate *g, size_t minTail, float32_t decayTime, float32_t maxGain)
+{
+	if (g == NULL) return;
+
+	g->minTail = minTail;
+	g->decayTime = (decayTime > 0.f) ? decayTime : 0.f;
+	g->maxGain = (maxGain > 1.f) ? maxGain : 1.f;
+
+	//	Work the tail out again in case the input is already silent
+	g->silentSamples = 0;
+
+	return;
+}
+
+
+//	Start over as if the input had just stopped being silent.  The resting level is kept
+void silenceGateReset(SilenceGate *g)
+{
+	if (g == NULL) return;
+
+	g->peak = 0.f;
+	g->tailLength = 0;
+	g->silentSamples = 0;
+	g->bypassed = 0;
+
+	return;
+}
+
+
+//	Check a block of input before it is processed.  Returns 1 if the filter can be bypassed for this block, meaning
+//	that its input has been silent for longer than its tail, or 0 if it has to process the block.  The first block
+//	that isn't silent wakes the filter up again
+int silenceGateProcess(SilenceGate *g, const float32_t *x, size_t n)
+{
+	if ((g == NULL) || (x == NULL) || (n == 0)) return 0;
+
+	if (!g->dcValid)
+	{
+		g->dc = x[0];
+		g->dcValid = 1;
+	}
+
+	//	Sum, energy and peak of the deviation from the resting level
+	float32_t dc = g->dc;
+	float32_t sum = 0.f;
+	float32_t energy0 = 0.f;
+	float32_t energy1 = 0.f;
+	float32_t peak = 0.f;
+	size_t i = 0;
+
+	for (; i + 2 <= n; i += 2)
+	{
+		float32_t d0 = x[i] - dc;
+		float32_t d1 = x[i + 1] - dc;
+
+		sum += d0 + d1;
+		energy0 += d0 * d0;
+		energy1 += d1 * d1;
+
+		peak = (fabsf(d0) > peak) ? fabsf(d0) : peak;
+		peak = (fabsf(d1) > peak) ? fabsf(d1) : peak;
+	}
+
+	for (; i < n; ++i)
+	{
+		float32_t d0 = x[i] - dc;
+
+		sum += d0;
+		energy0 += d0 * d0;
+		peak = (fabsf(d0) > peak) ? fabsf(d0) : peak;
+	}
+
+	//	Move the resting level towards the block's mean, by n / (n + SILENCE_GATE_DC_SAMPLES) of the way
+	g->dc += sum / (float32_t)(n + SILENCE_GATE_DC_SAMPLES);
+
+	if ((energy0 + energy1) > (g->threshold * g->threshold * (float32_t)n))
+	{
+		if (peak > g->peak)
+			g->peak = peak;
+
+		g->silentSamples = 0;
+		g->bypassed = 0;
+
+		return 0;
+	}
+
+	if (g->bypassed)
+		return 1;
+
+	//	The input has just gone silent.  Work out how long the filter keeps ringing from the loudest input it has had
+	if (g->silentSamples == 0)
+	{
+		float32_t ratio = (g->peak * g->maxGain) / g->threshold;
+
+		float32_t tail = (ratio > 1.f) ? ceilf(g->decayTime * logf(ratio)) : 0.f;
+
+		//	A loop that never decays is never bypassed
+		if (tail < (float32_t)(SIZE_MAX - g->minTail))
+			g->tailLength = g->minTail + (size_t)tail;
+		else
+			g->tailLength = SIZE_MAX;
+	}
+
+	if (g->silentSamples >= g->tailLength)
+	{
+		g->bypassed = 1;
+		g->peak = 0.f;
+
+		return 1;
+	}
+
+	g->silentSamples = ((g->tailLength - g->silentSamples) > n) ? (g->silentSamples + n) : g->tailLength;
+
+	return 0;
+}
+
+
+//	Resting level of the input, which a bypassed filter is settled on
+float32_t silenceGateLevel(const SilenceGate *g)
+{
+	if ((g == NULL) || !g->dcValid) return 0.f;
+
+	return g->dc;
+}
+
+
+//	Number of samples a feedback loop with gain feedbackGain around a delay of M samples takes to decay by a factor
+//	of e: the loop loses ln(1 / |feedbackGain|) every M samples
+float32_t silenceGateDecayTime(float32_t feedbackGain, size_t M)
+{
+	float32_t g = fabsf(feedbackGain);
+
+	if (g <= 0.f)
+		return 0.f;
+
+	if (g >= 1.f)
+		return INFINITY;
+
+	return (float32_t)M / -logf(g);
+}
+
+
+//	Largest ratio between the output and the input of a feedback loop with gain feedbackGain: 1 / (1 - |feedbackGain|)
+float32_t silenceGateLoopGain(float32_t feedbackGain)
+{
+	float32_t g = fabsf(feedbackGain);
+
+	if (g >= 1.f)
+		return INFINITY;
+
+	return 1.f / (1.f - g);
+}
+
+
@@ -8,6 +8,7 @@
 
 #include "DelayLine.h"
 #include "CombFilter.h"
+#include "SilenceGate.h"
 
 #define NUM_BUFFERS 4
 #define BUFFER_SIZE 512
@@ -15,6 +16,11 @@
 
 #define NUM_FILTER_COEFFS 9
 
+//	Blocks are skipped once the input has stayed within this RMS level of its resting level (mid-scale for the ADC,
+//	tracked as it goes) for longer than the filter's tail takes to decay below it: 1 LSB of the 12-bit DAC.  Raise it
+//	above the ADC's idle noise if the filter never stops
+#define SILENCE_THRESHOLD 1.f
+
 //  Create buffers
 volatile static float32_t buffer[NUM_BUFFERS][BUFFER_SIZE];
 
@@ -169,6 +175,16 @@ int main(void)
   if ((d == NULL) || (ff == NULL) || (fb == NULL) || (ap == NULL))
 	  return 0;
 
+  //	Tail of the filter in use.  The delay line and FFCF stop ringing delayLength samples after their input does.
+  //	For the FBCF and APCF the tail depends on how loud the input was and on the feedback gain:
+  //	silenceGateInit(&gate, SILENCE_THRESHOLD, delayLength, silenceGateDecayTime(0.8f, delayLength), silenceGateLoopGain(0.8f));
+  SilenceGate gate;
+  silenceGateInit(&gate, SILENCE_THRESHOLD, delayLength, 0.f, 1.f);
+
+  //	Once the tail has died out the filter's output settles at its DC gain times the input's resting level.  The FFCF
+  //	passes DC with a gain of b0 + bM = 1.8, the delay line and APCF with 1 and the FBCF with b0 / (1 - aM) = 1 / 1.8
+  const float32_t dcGain = 1.8f;
+
 
   TIMER_Enable(TIMER0, true);
 
@@ -180,18 +196,20 @@ int main(void)
 	  if (processingQueue[processingQueueHead] != NULL)
 	  {
 		  //  Fancy processing code here
-		  //  Apply delay lines or comb filters.  To observe the effects of the delay line or comb filter, comment out ffcfShift()
-		  //  and uncomment the filter / delay line that you want to use.  Only one shift function should be uncommented at a time.
-		  for (int i = 0; i < BUFFER_SIZE; ++i)
+		  //  Apply delay lines or comb filters.  To observe the effects of the delay line or comb filter, comment out ffcfProcessBlock()
+		  //  and uncomment the filter / delay line that you want to use.  Only one block function should be uncommented at a time.
+		  //  Each one processes the whole buffer at once
+		  float32_t *block = (float32_t *)processingQueue[processingQueueHead];
+
+		  //	Nothing left to hear from the filter, so output the level it has settled at without running it
+		  if (silenceGateProcess(&gate, block, BUFFER_SIZE))
+			  arm_fill_f32(dcGain * silenceGateLevel(&gate), block, BUFFER_SIZE);
+		  else
 		  {
-			  float32_t y = 0.0f;
-
-			  //delayLineShift(d, processingQueue[processingQueueHead][i], &y);
-			  ffcfShift(ff, processingQueue[processingQueueHead][i], &y);
-			  //fbcfShift(fb, processingQueue[processingQueueHead][i], &y);
-			  //apcfShift(ap, processingQueue[processingQueueHead][i], &y);
-
-			  processingQueue[processingQueueHead][i] = y;
+			  //delayLineProcessBlock(d, block, block, BUFFER_SIZE);
+			  ffcfProcessBlock(ff, block, block, BUFFER_SIZE);
+			  //fbcfProcessBlock(fb, block, block, BUFFER_SIZE);
+			  //apcfProcessBlock(ap, block, block, BUFFER_SIZE);
 		  }
 
 	      transferBufferToQueue(processingQueue[processingQueueHead], dacQueue, &dacQueueTail);
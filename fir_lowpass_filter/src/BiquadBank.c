@@ -0,0 +1,298 @@
+/*
+ * BiquadBank.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "BiquadBank.h"
+
+
+BiquadBank *createBiquadBank(size_t numBands, size_t maxBlockSize)
+{
+	if ((numBands == 0) || (numBands > BIQUAD_BANK_MAX_BANDS) || (maxBlockSize == 0))
+		return NULL;
+
+	BiquadBank *b = (BiquadBank *)malloc(sizeof(BiquadBank));
+	if (b == NULL)
+		return NULL;
+
+	b->sum = (float32_t *)malloc(sizeof(float32_t) * maxBlockSize);
+	if (b->sum == NULL)
+	{
+		free(b);
+		return NULL;
+	}
+
+	b->numBands = numBands;
+	b->numLanes = (numBands + 3) & ~(size_t)3;
+	b->maxBlockSize = maxBlockSize;
+
+	//	Every band starts out silent
+	arm_fill_f32(0.f, b->b0, BIQUAD_BANK_MAX_BANDS);
+	arm_fill_f32(0.f, b->b1, BIQUAD_BANK_MAX_BANDS);
+	arm_fill_f32(0.f, b->b2, BIQUAD_BANK_MAX_BANDS);
+	arm_fill_f32(0.f, b->a1, BIQUAD_BANK_MAX_BANDS);
+	arm_fill_f32(0.f, b->a2, BIQUAD_BANK_MAX_BANDS);
+
+	biquadBankReset(b);
+
+	return b;
+}
+
+
+void deleteBiquadBank(BiquadBank *b)
+{
+	if (b == NULL) return;
+
+	if (b->sum != NULL)
+	{
+		free(b->sum);
+		b->sum = NULL;
+	}
+
+	free(b);
+	b = NULL;
+
+	return;
+}
+
+
+void biquadBankReset(BiquadBank *b)
+{
+	if (b == NULL) return;
+
+	arm_fill_f32(0.f, b->d1, BIQUAD_BANK_MAX_BANDS);
+	arm_fill_f32(0.f, b->d2, BIQUAD_BANK_MAX_BANDS);
+
+	return;
+}
+
+
+//	coeffs is one stage in the layout of BiquadCascade, so a band can be taken from any of its designers
+int biquadBankSetBand(BiquadBank *b, size_t band, const float32_t *coeffs)
+{
+	if ((b == NULL) || (coeffs == NULL)) return -1;
+	if (band >= b->numBands) return -1;
+
+	b->b0[band] = coeffs[0];
+	b->b1[band] = coeffs[1];
+	b->b2[band] = coeffs[2];
+	b->a1[band] = coeffs[3];
+	b->a2[band] = coeffs[4];
+
+	return 0;
+}
+
+
+//	Bandpass centred on fc with a peak gain of gain, for the bands of a graphic EQ.  Q is fc over the -3 dB bandwidth
+int biquadBankDesignBand(BiquadBank *b, size_t band, float32_t fc, float32_t Q, float32_t gain, float32_t fs)
+{
+	if ((fs <= 0.f) || (fc <= 0.f) || (fc >= fs / 2.f) || (Q <= 0.f)) return -1;
+
+	float32_t w0 = 2.f * PI * fc / fs;
+	float32_t alpha = arm_sin_f32(w0) / (2.f * Q);
+	float32_t a0 = 1.f + alpha;
+	float32_t coeffs[5];
+
+	coeffs[0] = gain * alpha / a0;
+	coeffs[1] = 0.f;
+	coeffs[2] = -gain * alpha / a0;
+	coeffs[3] = 2.f * arm_cos_f32(w0) / a0;
+	coeffs[4] = -(1.f - alpha) / a0;
+
+	return biquadBankSetBand(b, band, coeffs);
+}
+
+
+//	Advance bands first up to first + (4 * G) - 1 over n samples.  If sum isn't NULL their outputs are added into it,
+//	otherwise they are written to tile interleaved, 4 * G outputs per sample.  Called with a constant G so that the
+//	groups are unrolled and their states stay in registers
+static inline void biquadBankPass(BiquadBank *b, size_t first, size_t G, const float32_t *x, float32_t *sum, float32_t *tile, size_t n)
+{
+#if defined(__SSE__) || defined(_M_X64)
+	__m128 b0[4], b1[4], b2[4], a1[4], a2[4], d1[4], d2[4];
+
+	for (size_t g = 0; g < G; ++g)
+	{
+		size_t k = first + (4 * g);
+
+		b0[g] = _mm_loadu_ps(b->b0 + k);
+		b1[g] = _mm_loadu_ps(b->b1 + k);
+		b2[g] = _mm_loadu_ps(b->b2 + k);
+		a1[g] = _mm_loadu_ps(b->a1 + k);
+		a2[g] = _mm_loadu_ps(b->a2 + k);
+		d1[g] = _mm_loadu_ps(b->d1 + k);
+		d2[g] = _mm_loadu_ps(b->d2 + k);
+	}
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		__m128 in = _mm_set1_ps(x[i]);
+		__m128 total = _mm_setzero_ps();
+
+		for (size_t g = 0; g < G; ++g)
+		{
+			__m128 out = _mm_add_ps(_mm_mul_ps(b0[g], in), d1[g]);
+
+			d1[g] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b1[g], in), _mm_mul_ps(a1[g], out)), d2[g]);
+			d2[g] = _mm_add_ps(_mm_mul_ps(b2[g], in), _mm_mul_ps(a2[g], out));
+
+			if (sum != NULL)
+				total = _mm_add_ps(total, out);
+			else
+				_mm_storeu_ps(tile + (i * 4 * G) + (4 * g), out);
+		}
+
+		if (sum != NULL)
+		{
+			total = _mm_add_ps(total, _mm_movehl_ps(total, total));
+			total = _mm_add_ss(total, _mm_shuffle_ps(total, total, 1));
+			sum[i] += _mm_cvtss_f32(total);
+		}
+	}
+
+	for (size_t g = 0; g < G; ++g)
+	{
+		_mm_storeu_ps(b->d1 + first + (4 * g), d1[g]);
+		_mm_storeu_ps(b->d2 + first + (4 * g), d2[g]);
+	}
+#else
+	float32_t b0[BIQUAD_BANK_PASS_BANDS], b1[BIQUAD_BANK_PASS_BANDS], b2[BIQUAD_BANK_PASS_BANDS];
+	float32_t a1[BIQUAD_BANK_PASS_BANDS], a2[BIQUAD_BANK_PASS_BANDS];
+	float32_t d1[BIQUAD_BANK_PASS_BANDS], d2[BIQUAD_BANK_PASS_BANDS];
+	size_t numLanes = 4 * G;
+
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		b0[j] = b->b0[first + j];
+		b1[j] = b->b1[first + j];
+		b2[j] = b->b2[first + j];
+		a1[j] = b->a1[first + j];
+		a2[j] = b->a2[first + j];
+		d1[j] = b->d1[first + j];
+		d2[j] = b->d2[first + j];
+	}
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float32_t in = x[i];
+		float32_t total = 0.f;
+
+		for (size_t j = 0; j < numLanes; ++j)
+		{
+			float32_t out = (b0[j] * in) + d1[j];
+
+			d1[j] = (b1[j] * in) + (a1[j] * out) + d2[j];
+			d2[j] = (b2[j] * in) + (a2[j] * out);
+
+			if (sum != NULL)
+				total += out;
+			else
+				tile[(i * numLanes) + j] = out;
+		}
+
+		if (sum != NULL)
+			sum[i] += total;
+	}
+
+	for (size_t j = 0; j < numLanes; ++j)
+	{
+		b->d1[first + j] = d1[j];
+		b->d2[first + j] = d2[j];
+	}
+#endif
+}
+
+
+//	Run the pass that starts at band first, returns the number of bands it covered
+static size_t biquadBankRunPass(BiquadBank *b, size_t first, const float32_t *x, float32_t *sum, float32_t *tile, size_t n)
+{
+	size_t G = (b->numLanes - first) / 4;
+
+	if (G >= 4)
+	{
+		biquadBankPass(b, first, 4, x, sum, tile, n);
+		return 16;
+	}
+
+	if (G == 3)
+		biquadBankPass(b, first, 3, x, sum, tile, n);
+	else if (G == 2)
+		biquadBankPass(b, first, 2, x, sum, tile, n);
+	else
+		biquadBankPass(b, first, 1, x, sum, tile, n);
+
+	return 4 * G;
+}
+
+
+//	Process a block of n samples through every band and write the sum of the band outputs to y.  x and y may point to
+//	the same buffer
+int biquadBankProcessBlock(BiquadBank *b, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((b == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	while (n > 0)
+	{
+		size_t count = (n < b->maxBlockSize) ? n : b->maxBlockSize;
+
+		//	Every pass needs the input, so the outputs are summed to the side and only copied out at the end
+		arm_fill_f32(0.f, b->sum, count);
+
+		for (size_t first = 0; first < b->numLanes; )
+			first += biquadBankRunPass(b, first, x, b->sum, NULL, count);
+
+		arm_copy_f32(b->sum, y, count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+//	Process a block of n samples through every band and write band k's output to y[k], which must hold n samples.
+//	x must not be one of the band outputs.  The block is run BIQUAD_BANK_TILE samples at a time: each pass writes its
+//	outputs interleaved into a small tile, which is then copied out to the bands' buffers, so the band buffers are
+//	written one contiguous run at a time instead of one sample of every band at a time
+int biquadBankProcessBlockSeparate(BiquadBank *b, const float32_t *x, float32_t *const *y, size_t n)
+{
+	if ((b == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	for (size_t k = 0; k < b->numBands; ++k)
+	{
+		if ((y[k] == NULL) || (y[k] == x)) return -1;
+	}
+
+	float32_t tile[BIQUAD_BANK_TILE * BIQUAD_BANK_PASS_BANDS];
+	size_t offset = 0;
+
+	while (n > 0)
+	{
+		size_t count = (n < BIQUAD_BANK_TILE) ? n : BIQUAD_BANK_TILE;
+
+		for (size_t first = 0; first < b->numLanes; )
+		{
+			size_t lanes = biquadBankRunPass(b, first, x + offset, NULL, tile, count);
+
+			for (size_t j = 0; (j < lanes) && (first + j < b->numBands); ++j)
+			{
+				float32_t *band = y[first + j] + offset;
+
+				for (size_t i = 0; i < count; ++i)
+					band[i] = tile[(i * lanes) + j];
+			}
+
+			first += lanes;
+		}
+
+		offset += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
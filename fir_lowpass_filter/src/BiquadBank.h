@@ -0,0 +1,58 @@
+/*
+ * BiquadBank.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_BIQUADBANK_H_
+#define SRC_BIQUADBANK_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include "xmmintrin.h"
+#endif
+
+
+#define BIQUAD_BANK_MAX_BANDS 32
+
+//	Number of bands advanced together, sample by sample, in one pass over the block
+#define BIQUAD_BANK_PASS_BANDS 16
+
+//	Number of samples biquadBankProcessBlockSeparate() runs at a time
+#define BIQUAD_BANK_TILE 32
+
+
+//	Bank of biquads that all get the same input, for graphic EQs and crossovers.  Every band is one second order
+//	section with the {b0, b1, b2, a1, a2} layout of BiquadCascade.  The coefficients and states are stored per
+//	coefficient across the bands (structure of arrays), so a group of four bands is advanced with one vector operation
+//	per term.  The bands are processed in passes of up to BIQUAD_BANK_PASS_BANDS, and within a pass the states stay in
+//	registers for the whole block.  Bands past numBands up to a multiple of four have zero coefficients.
+//	Band outputs are either summed into one output or written to one buffer per band
+typedef struct
+{
+	size_t numBands;
+	size_t numLanes;			//	numBands rounded up to a multiple of 4
+	size_t maxBlockSize;
+	float32_t b0[BIQUAD_BANK_MAX_BANDS];
+	float32_t b1[BIQUAD_BANK_MAX_BANDS];
+	float32_t b2[BIQUAD_BANK_MAX_BANDS];
+	float32_t a1[BIQUAD_BANK_MAX_BANDS];
+	float32_t a2[BIQUAD_BANK_MAX_BANDS];
+	float32_t d1[BIQUAD_BANK_MAX_BANDS];
+	float32_t d2[BIQUAD_BANK_MAX_BANDS];
+	float32_t *sum;				//	maxBlockSize samples the summed output is accumulated in
+}BiquadBank;
+
+
+BiquadBank	*createBiquadBank(size_t numBands, size_t maxBlockSize);
+void		deleteBiquadBank(BiquadBank *b);
+void		biquadBankReset(BiquadBank *b);
+int			biquadBankSetBand(BiquadBank *b, size_t band, const float32_t *coeffs);
+int			biquadBankDesignBand(BiquadBank *b, size_t band, float32_t fc, float32_t Q, float32_t gain, float32_t fs);
+int			biquadBankProcessBlock(BiquadBank *b, const float32_t *x, float32_t *y, size_t n);
+int			biquadBankProcessBlockSeparate(BiquadBank *b, const float32_t *x, float32_t *const *y, size_t n);
+
+
+#endif /* SRC_BIQUADBANK_H_ */
@@ -0,0 +1,226 @@
+/*
+ * BiquadCascade.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "BiquadCascade.h"
+
+
+BiquadCascade *createBiquadCascade(size_t numStages, const float32_t *coeffs)
+{
+	BiquadCascade *c = (BiquadCascade *)malloc(sizeof(BiquadCascade));
+	if (c == NULL)
+		return NULL;
+
+	if (biquadCascadeInit(c, numStages, coeffs) < 0)
+	{
+		free(c);
+		return NULL;
+	}
+
+	return c;
+}
+
+
+void deleteBiquadCascade(BiquadCascade *c)
+{
+	if (c == NULL) return;
+
+	free(c);
+	c = NULL;
+
+	return;
+}
+
+
+//	coeffs holds 5 * numStages coefficients, see BiquadCascade
+int biquadCascadeInit(BiquadCascade *c, size_t numStages, const float32_t *coeffs)
+{
+	if ((c == NULL) || (coeffs == NULL)) return -1;
+	if ((numStages == 0) || (numStages > BIQUAD_CASCADE_MAX_STAGES)) return -1;
+
+	c->numStages = numStages;
+	arm_copy_f32((float32_t *)coeffs, c->coeffs, 5 * numStages);
+	biquadCascadeReset(c);
+
+	return 0;
+}
+
+
+void biquadCascadeReset(BiquadCascade *c)
+{
+	if (c == NULL) return;
+
+	arm_fill_f32(0.f, c->state, 2 * BIQUAD_CASCADE_MAX_STAGES);
+
+	return;
+}
+
+
+//	Run the block through one stage at a time, so each stage's coefficients and state stay in registers for the whole
+//	block.  x and y may point to the same buffer
+int biquadCascadeProcessBlock(BiquadCascade *c, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((c == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	const float32_t *input = x;
+
+	for (size_t s = 0; s < c->numStages; ++s)
+	{
+		const float32_t *k = c->coeffs + (5 * s);
+		float32_t b0 = k[0];
+		float32_t b1 = k[1];
+		float32_t b2 = k[2];
+		float32_t a1 = k[3];
+		float32_t a2 = k[4];
+		float32_t d1 = c->state[2 * s];
+		float32_t d2 = c->state[(2 * s) + 1];
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			float32_t in = input[i];
+			float32_t out = (b0 * in) + d1;
+
+			d1 = (b1 * in) + (a1 * out) + d2;
+			d2 = (b2 * in) + (a2 * out);
+
+			y[i] = out;
+		}
+
+		c->state[2 * s] = d1;
+		c->state[(2 * s) + 1] = d2;
+
+		//	Every stage after the first works on the previous stage's output
+		input = y;
+	}
+
+	return 0;
+}
+
+
+//	Normalise by a0 and negate a1 and a2 for the layout in BiquadCascade
+static void biquadSetStage(float32_t *k, float32_t b0, float32_t b1, float32_t b2, float32_t a0, float32_t a1, float32_t a2)
+{
+	k[0] = b0 / a0;
+	k[1] = b1 / a0;
+	k[2] = b2 / a0;
+	k[3] = -a1 / a0;
+	k[4] = -a2 / a0;
+}
+
+
+//	Bilinear transform of an order-th order Butterworth, prewarped to fc, appended to the cascade as one second order
+//	section per pole pair (with quality factor Q = 1 / (2 * cos(angle of the pole pair))) and a first order section
+//	for the real pole of an odd order
+static int biquadAppendButterworth(BiquadCascade *c, BiquadResponse response, size_t order, float32_t fc, float32_t fs)
+{
+	if (c->numStages + ((order + 1) / 2) > BIQUAD_CASCADE_MAX_STAGES)
+		return -1;
+
+	float32_t w0 = 2.f * PI * fc / fs;
+	float32_t sinW0 = arm_sin_f32(w0);
+	float32_t cosW0 = arm_cos_f32(w0);
+
+	for (size_t k = 0; k < order / 2; ++k)
+	{
+		//	Pole pairs are at (2k + 1) * pi / (2 * order) from the negative real axis for an even order and at
+		//	(k + 1) * pi / order for an odd one
+		float32_t angle = (order % 2 == 0) ? (PI * (float32_t)((2 * k) + 1) / (float32_t)(2 * order)) : (PI * (float32_t)(k + 1) / (float32_t)order);
+		float32_t Q = 1.f / (2.f * arm_cos_f32(angle));
+		float32_t alpha = sinW0 / (2.f * Q);
+		float32_t *stage = c->coeffs + (5 * c->numStages++);
+
+		if (response == BIQUAD_LOWPASS)
+			biquadSetStage(stage, (1.f - cosW0) / 2.f, 1.f - cosW0, (1.f - cosW0) / 2.f, 1.f + alpha, -2.f * cosW0, 1.f - alpha);
+		else
+			biquadSetStage(stage, (1.f + cosW0) / 2.f, -(1.f + cosW0), (1.f + cosW0) / 2.f, 1.f + alpha, -2.f * cosW0, 1.f - alpha);
+	}
+
+	if (order % 2 == 1)
+	{
+		float32_t K = sinW0 / (1.f + cosW0);		//	tan(w0 / 2)
+		float32_t *stage = c->coeffs + (5 * c->numStages++);
+
+		if (response == BIQUAD_LOWPASS)
+			biquadSetStage(stage, K, K, 0.f, 1.f + K, K - 1.f, 0.f);
+		else
+			biquadSetStage(stage, 1.f, -1.f, 0.f, 1.f + K, K - 1.f, 0.f);
+	}
+
+	return 0;
+}
+
+
+//	A Linkwitz-Riley highpass is 180 degrees out of phase with its lowpass when the Butterworth it squares has an odd
+//	order (LR2, LR6), so the two would sum to a notch at fc.  The highpass's first stage is inverted for those orders,
+//	which makes every LP + HP pair sum to an allpass
+static int biquadAppendDesign(BiquadCascade *c, BiquadAlignment alignment, BiquadResponse response, size_t order, float32_t fc, float32_t fs)
+{
+	if (alignment == BIQUAD_BUTTERWORTH)
+		return biquadAppendButterworth(c, response, order, fc, fs);
+
+	if (order % 2 != 0)
+		return -1;
+
+	size_t first = c->numStages;
+
+	if (biquadAppendButterworth(c, response, order / 2, fc, fs) < 0)
+		return -1;
+
+	if (biquadAppendButterworth(c, response, order / 2, fc, fs) < 0)
+		return -1;
+
+	if ((response == BIQUAD_HIGHPASS) && ((order / 2) % 2 == 1))
+	{
+		float32_t *stage = c->coeffs + (5 * first);
+
+		stage[0] = -stage[0];
+		stage[1] = -stage[1];
+		stage[2] = -stage[2];
+	}
+
+	return 0;
+}
+
+
+//	Design an order-th order lowpass or highpass with its cutoff at fc (-3 dB for Butterworth, -6 dB for
+//	Linkwitz-Riley) into c, replacing its coefficients and clearing its state
+int biquadCascadeDesign(BiquadCascade *c, BiquadAlignment alignment, BiquadResponse response, size_t order, float32_t fc, float32_t fs)
+{
+	if (c == NULL) return -1;
+	if ((order == 0) || (fs <= 0.f) || (fc <= 0.f) || (fc >= fs / 2.f)) return -1;
+
+	c->numStages = 0;
+
+	if (biquadAppendDesign(c, alignment, response, order, fc, fs) < 0)
+		return -1;
+
+	biquadCascadeReset(c);
+
+	return 0;
+}
+
+
+//	Design a bandpass as a highpass at fLow followed by a lowpass at fHigh, each of the given order, the way the bands of
+//	a crossover are made.  The band should be at least an octave or so wide, otherwise the two skirts overlap and the
+//	passband sags
+int biquadCascadeDesignBandpass(BiquadCascade *c, BiquadAlignment alignment, size_t order, float32_t fLow, float32_t fHigh, float32_t fs)
+{
+	if (c == NULL) return -1;
+	if ((order == 0) || (fs <= 0.f) || (fLow <= 0.f) || (fLow >= fHigh) || (fHigh >= fs / 2.f)) return -1;
+
+	c->numStages = 0;
+
+	if (biquadAppendDesign(c, alignment, BIQUAD_HIGHPASS, order, fLow, fs) < 0)
+		return -1;
+
+	if (biquadAppendDesign(c, alignment, BIQUAD_LOWPASS, order, fHigh, fs) < 0)
+		return -1;
+
+	biquadCascadeReset(c);
+
+	return 0;
+}
+
+
@@ -0,0 +1,56 @@
+/*
+ * BiquadCascade.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_BIQUADCASCADE_H_
+#define SRC_BIQUADCASCADE_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+
+#define BIQUAD_CASCADE_MAX_STAGES 8
+
+
+typedef enum
+{
+	BIQUAD_BUTTERWORTH = 0,
+	BIQUAD_LINKWITZ_RILEY		//	Two cascaded Butterworth filters of half the order, order must be even.  The highpass
+								//	is inverted for orders 2 and 6 so that lowpass plus highpass is flat for every order
+}BiquadAlignment;
+
+
+typedef enum
+{
+	BIQUAD_LOWPASS = 0,
+	BIQUAD_HIGHPASS
+}BiquadResponse;
+
+
+//	Cascade of second order sections in transposed direct form II, with the state kept per instance.
+//	Each stage's coefficients are {b0, b1, b2, a1, a2} with a1 and a2 negated, the layout
+//	arm_biquad_cascade_df2T_f32 uses:
+//		y[n] = b0 * x[n] + d1
+//		d1 = b1 * x[n] + a1 * y[n] + d2
+//		d2 = b2 * x[n] + a2 * y[n]
+typedef struct
+{
+	size_t numStages;
+	float32_t coeffs[5 * BIQUAD_CASCADE_MAX_STAGES];
+	float32_t state[2 * BIQUAD_CASCADE_MAX_STAGES];
+}BiquadCascade;
+
+
+BiquadCascade	*createBiquadCascade(size_t numStages, const float32_t *coeffs);
+void			deleteBiquadCascade(BiquadCascade *c);
+int				biquadCascadeInit(BiquadCascade *c, size_t numStages, const float32_t *coeffs);
+void			biquadCascadeReset(BiquadCascade *c);
+int				biquadCascadeProcessBlock(BiquadCascade *c, const float32_t *x, float32_t *y, size_t n);
+
+int				biquadCascadeDesign(BiquadCascade *c, BiquadAlignment alignment, BiquadResponse response, size_t order, float32_t fc, float32_t fs);
+int				biquadCascadeDesignBandpass(BiquadCascade *c, BiquadAlignment alignment, size_t order, float32_t fLow, float32_t fHigh, float32_t fs);
+
+
+#endif /* SRC_BIQUADCASCADE_H_ */
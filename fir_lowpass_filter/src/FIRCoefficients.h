@@ -0,0 +1,24 @@
+/*
+ * FIRCoefficients.h
+ *
+ * Generated by tools/generate_fir_coefficients.py, don't edit by hand
+ */
+
+#ifndef SRC_FIRCOEFFICIENTS_H_
+#define SRC_FIRCOEFFICIENTS_H_
+
+#include "arm_math.h"
+
+
+//	FIR_LPF_MAIN,1000,40000,9,none,1024
+#define FIR_LPF_MAIN_NUM_TAPS 9
+
+static const float32_t FIR_LPF_MAIN[FIR_LPF_MAIN_NUM_TAPS] =
+{
+	4.756217177e-02f, 4.903865147e-02f, 5.010973106e-02f, 5.075901993e-02f,
+	5.097656250e-02f, 5.075901993e-02f, 5.010973106e-02f, 4.903865147e-02f,
+	4.756217177e-02f
+};
+
+
+#endif /* SRC_FIRCOEFFICIENTS_H_ */
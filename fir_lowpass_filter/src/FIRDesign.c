@@ -0,0 +1,194 @@
+/*
+ * FIRDesign.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FIRDesign.h"
+
+
+int fir_calculateLPFCoefficients(float32_t fc, float32_t fs, const float32_t N, const uint32_t nTaps, float32_t *h)
+{
+	if ((h == NULL) ||(fs == 0) || (N == 0))
+		return -1;
+
+	if (nTaps % 2 == 0)
+		return -1;
+
+	float32_t passBandWidth = (2 * (N * fc / fs)) + 1;
+
+	//  Since you can only use positive integers to index arrays, h[k=0] is shifted out to index (nTaps - 1) / 2
+	//  We calculate h(k=0) explicitly here to avoid the divide by zero issues
+	h[(nTaps - 1) / 2] = passBandWidth / N;
+
+	//  Calculate the first (nTaps - 1) / 2 coefficients on the positive k axis
+	int hIndex = ((nTaps - 1) /2) + 1;
+	for (int i = 1; i <= (nTaps - 1) / 2; ++i)
+	{
+		float32_t numerator = arm_sin_f32(PI * i * passBandWidth / N);
+		float32_t denominator = arm_sin_f32(PI * i  / N);
+
+		h[hIndex++] = (1 / N) * (numerator / denominator);
+	}
+
+	//  Copy the calculated coefficients to the other half of the array to get the even symmetry
+	for (int i = 0; i < (nTaps - 1) / 2; ++i)
+		h[i] = h[nTaps - 1 - i];
+
+	return 0;
+}
+
+
+//	Zeroth order modified Bessel function of the first kind, summed until the terms stop adding anything
+static float32_t fir_besselI0(float32_t x)
+{
+	float32_t sum = 1.f;
+	float32_t term = 1.f;
+	float32_t halfX = 0.5f * x;
+
+	for (int k = 1; k < 64; ++k)
+	{
+		term *= (halfX / (float32_t)k) * (halfX / (float32_t)k);
+		sum += term;
+
+		if (term < (sum * 1e-8f))
+			break;
+	}
+
+	return sum;
+}
+
+
+//	Windowed-sinc lowpass: the ideal impulse response with a cutoff of fc, centred on (nTaps - 1) / 2, times the window,
+//	scaled to a gain of 1 at DC.  Unlike fir_calculateLPFCoefficients(), nTaps may be even
+int fir_calculateWindowedLPFCoefficients(float32_t fc, float32_t fs, const uint32_t nTaps, FIRWindow window, float32_t beta, float32_t *h)
+{
+	if ((h == NULL) || (fs <= 0.f) || (fc <= 0.f) || (fc >= (fs / 2)) || (nTaps < 2))
+		return -1;
+
+	if ((window != FIR_WINDOW_BLACKMAN) && (window != FIR_WINDOW_KAISER))
+		return -1;
+
+	float32_t wc = 2 * fc / fs;
+	float32_t centre = 0.5f * (float32_t)(nTaps - 1);
+	float32_t i0Beta = fir_besselI0(beta);
+
+	//	Only the first half is calculated, the second half is its mirror image
+	for (uint32_t i = 0; i < (nTaps + 1) / 2; ++i)
+	{
+		float32_t t = (float32_t)i - centre;
+		float32_t sinc = (t == 0.f) ? wc : (arm_sin_f32(PI * wc * t) / (PI * t));
+		float32_t w;
+
+		if (window == FIR_WINDOW_BLACKMAN)
+		{
+			float32_t phase = 2 * PI * (float32_t)i / (float32_t)(nTaps - 1);
+			w = 0.42f - (0.5f * arm_cos_f32(phase)) + (0.08f * arm_cos_f32(2 * phase));
+		}
+		else
+		{
+			float32_t r = t / centre;
+			float32_t root;
+
+			arm_sqrt_f32(1.f - (r * r), &root);
+			w = fir_besselI0(beta * root) / i0Beta;
+		}
+
+		h[i] = sinc * w;
+		h[nTaps - 1 - i] = h[i];
+	}
+
+	return fir_normalizeDCGain(h, nTaps, 1.f);
+}
+
+
+//	Design the lowpass filter spec describes into h, which must hold spec->nTaps coefficients
+int fir_design(const FIRDesignSpec *spec, float32_t *h)
+{
+	if (spec == NULL)
+		return -1;
+
+	if (spec->window == FIR_WINDOW_NONE)
+		return fir_calculateLPFCoefficients(spec->fc, spec->fs, spec->N, spec->nTaps, h);
+
+	return fir_calculateWindowedLPFCoefficients(spec->fc, spec->fs, spec->nTaps, spec->window, spec->beta, h);
+}
+
+
+//	Kaiser's formula for the beta that gives a stopband attenuation of attenuation dB
+float32_t fir_kaiserBeta(float32_t attenuation)
+{
+	if (attenuation > 50.f)
+		return 0.1102f * (attenuation - 8.7f);
+
+	if (attenuation >= 21.f)
+		return (0.5842f * powf(attenuation - 21.f, 0.4f)) + (0.07886f * (attenuation - 21.f));
+
+	return 0.f;
+}
+
+
+//	Kaiser's estimate of the number of taps a Kaiser window needs for attenuation dB of stopband attenuation with a
+//	transition band transitionWidth Hz wide, rounded up to an odd number so the filter has a centre tap
+uint32_t fir_kaiserNumTaps(float32_t attenuation, float32_t transitionWidth, float32_t fs)
+{
+	if ((transitionWidth <= 0.f) || (fs <= 0.f))
+		return 0;
+
+	float32_t order = (attenuation - 7.95f) / (14.36f * transitionWidth / fs);
+	uint32_t nTaps = (order > 0.f) ? ((uint32_t)ceilf(order) + 1) : 1;
+
+	return nTaps | 1;
+}
+
+
+//	Scale h so that its gain at DC (the sum of the coefficients) is gain.  The decimators want a gain of 1 and the
+//	interpolators a gain of their factor, to make up for the zeros stuffed between the input samples
+int fir_normalizeDCGain(float32_t *h, const uint32_t nTaps, float32_t gain)
+{
+	if ((h == NULL) || (nTaps == 0))
+		return -1;
+
+	float32_t sum = 0.f;
+	for (uint32_t i = 0; i < nTaps; ++i)
+		sum += h[i];
+
+	if (sum == 0.f)
+		return -1;
+
+	arm_scale_f32(h, gain / sum, h, nTaps);
+
+	return 0;
+}
+
+
+//	Round h to Q15, saturating coefficients outside [-1, 1).  If maxResponseError isn't NULL it receives the sum of
+//	|h - hq| over the taps, the most the quantised filter's response can differ from h's at any frequency
+int fir_quantizeQ15(const float32_t *h, const uint32_t nTaps, q15_t *hq, float32_t *maxResponseError)
+{
+	if ((h == NULL) || (hq == NULL) || (nTaps == 0))
+		return -1;
+
+	float32_t error = 0.f;
+
+	for (uint32_t i = 0; i < nTaps; ++i)
+	{
+		float32_t scaled = h[i] * 32768.f;
+		int32_t q = (int32_t)((scaled < 0.f) ? (scaled - 0.5f) : (scaled + 0.5f));
+
+		if (q > 32767)
+			q = 32767;
+		else if (q < -32768)
+			q = -32768;
+
+		hq[i] = (q15_t)q;
+		error += fabsf(h[i] - ((float32_t)q / 32768.f));
+	}
+
+	if (maxResponseError != NULL)
+		*maxResponseError = error;
+
+	return 0;
+}
+
+
@@ -0,0 +1,46 @@
+/*
+ * FIRDesign.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FIRDESIGN_H_
+#define SRC_FIRDESIGN_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+
+//	Window applied to the ideal lowpass impulse response.  FIR_WINDOW_NONE is fir_calculateLPFCoefficients()'s
+//	frequency-sampled design, the only one that uses N.  Blackman gives about 74 dB of stopband attenuation with a
+//	transition band of about 5.5 * fs / nTaps; Kaiser trades the two against each other with beta
+typedef enum
+{
+	FIR_WINDOW_NONE = 0,
+	FIR_WINDOW_BLACKMAN,
+	FIR_WINDOW_KAISER
+}FIRWindow;
+
+
+//	Everything a lowpass design depends on.  Fields a window doesn't use are ignored
+typedef struct
+{
+	float32_t fc;
+	float32_t fs;
+	float32_t N;				//	FIR_WINDOW_NONE only
+	uint32_t nTaps;
+	FIRWindow window;
+	float32_t beta;				//	FIR_WINDOW_KAISER only
+}FIRDesignSpec;
+
+
+int		fir_calculateLPFCoefficients(float32_t fc, float32_t fs, const float32_t N, const uint32_t nTaps, float32_t *h);
+int		fir_normalizeDCGain(float32_t *h, const uint32_t nTaps, float32_t gain);
+int		fir_calculateWindowedLPFCoefficients(float32_t fc, float32_t fs, const uint32_t nTaps, FIRWindow window, float32_t beta, float32_t *h);
+int		fir_design(const FIRDesignSpec *spec, float32_t *h);
+float32_t	fir_kaiserBeta(float32_t attenuation);
+uint32_t	fir_kaiserNumTaps(float32_t attenuation, float32_t transitionWidth, float32_t fs);
+int		fir_quantizeQ15(const float32_t *h, const uint32_t nTaps, q15_t *hq, float32_t *maxResponseError);
+
+
+#endif /* SRC_FIRDESIGN_H_ */
@@ -0,0 +1,148 @@
+/*
+ * FIRDesignCache.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FIRDesignCache.h"
+#include "string.h"
+
+
+//	The entries and the coefficients are allocated as one buffer, entries first
+FIRDesignCache *createFIRDesignCache(size_t numEntries, uint32_t maxTaps)
+{
+	if ((numEntries == 0) || (maxTaps == 0))
+		return NULL;
+
+	FIRDesignCache *c = (FIRDesignCache *)malloc(sizeof(FIRDesignCache));
+	if (c == NULL)
+		return NULL;
+
+	size_t entriesSize = sizeof(FIRDesignCacheEntry) * numEntries;
+
+	c->entries = (FIRDesignCacheEntry *)malloc(entriesSize + (sizeof(float32_t) * maxTaps * numEntries));
+	if (c->entries == NULL)
+	{
+		free(c);
+		return NULL;
+	}
+
+	float32_t *coeffs = (float32_t *)((uint8_t *)c->entries + entriesSize);
+
+	for (size_t i = 0; i < numEntries; ++i)
+		c->entries[i].h = coeffs + (i * maxTaps);
+
+	c->numEntries = numEntries;
+	c->maxTaps = maxTaps;
+
+	firDesignCacheClear(c);
+
+	return c;
+}
+
+
+void deleteFIRDesignCache(FIRDesignCache *c)
+{
+	if (c == NULL) return;
+
+	if (c->entries != NULL)
+	{
+		free(c->entries);
+		c->entries = NULL;
+	}
+
+	free(c);
+	c = NULL;
+
+	return;
+}
+
+
+void firDesignCacheClear(FIRDesignCache *c)
+{
+	if (c == NULL) return;
+
+	for (size_t i = 0; i < c->numEntries; ++i)
+	{
+		c->entries[i].valid = 0;
+		c->entries[i].lastUsed = 0;
+	}
+
+	c->clock = 0;
+	c->hits = 0;
+	c->misses = 0;
+
+	return;
+}
+
+
+//	Copy spec with the fields its window ignores set to 0, so that they can't make two identical designs miss
+static FIRDesignSpec firDesignCacheKey(const FIRDesignSpec *spec)
+{
+	FIRDesignSpec key;
+
+	memset(&key, 0, sizeof(FIRDesignSpec));
+	key.fc = spec->fc;
+	key.fs = spec->fs;
+	key.nTaps = spec->nTaps;
+	key.window = spec->window;
+
+	if (spec->window == FIR_WINDOW_NONE)
+		key.N = spec->N;
+
+	if (spec->window == FIR_WINDOW_KAISER)
+		key.beta = spec->beta;
+
+	return key;
+}
+
+
+static int firDesignCacheMatch(const FIRDesignSpec *a, const FIRDesignSpec *b)
+{
+	return (a->fc == b->fc) && (a->fs == b->fs) && (a->N == b->N) && (a->nTaps == b->nTaps) && (a->window == b->window) && (a->beta == b->beta);
+}
+
+
+//	Returns spec->nTaps coefficients for spec, designing them on a miss, or NULL if the design fails or doesn't fit.
+//	The coefficients stay valid until numEntries other designs have been looked up since this one was last used
+const float32_t *firDesignCacheGet(FIRDesignCache *c, const FIRDesignSpec *spec)
+{
+	if ((c == NULL) || (spec == NULL)) return NULL;
+	if ((spec->nTaps == 0) || (spec->nTaps > c->maxTaps)) return NULL;
+
+	FIRDesignSpec key = firDesignCacheKey(spec);
+	FIRDesignCacheEntry *victim = &c->entries[0];
+
+	++c->clock;
+
+	for (size_t i = 0; i < c->numEntries; ++i)
+	{
+		FIRDesignCacheEntry *e = &c->entries[i];
+
+		if (e->valid && firDesignCacheMatch(&e->spec, &key))
+		{
+			e->lastUsed = c->clock;
+			++c->hits;
+
+			return e->h;
+		}
+
+		//	An empty entry is taken before any used one
+		if (victim->valid && (!e->valid || (e->lastUsed < victim->lastUsed)))
+			victim = e;
+	}
+
+	++c->misses;
+
+	victim->valid = 0;
+	if (fir_design(&key, victim->h) < 0)
+		return NULL;
+
+	victim->spec = key;
+	victim->lastUsed = c->clock;
+	victim->valid = 1;
+
+	return victim->h;
+}
+
+
@@ -0,0 +1,45 @@
+/*
+ * FIRDesignCache.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FIRDESIGNCACHE_H_
+#define SRC_FIRDESIGNCACHE_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "FIRDesign.h"
+
+
+typedef struct
+{
+	FIRDesignSpec spec;			//	With the fields its window doesn't use cleared
+	float32_t *h;				//	maxTaps coefficients
+	uint32_t lastUsed;
+	int valid;
+}FIRDesignCacheEntry;
+
+
+//	Keeps the coefficients of the last numEntries lowpass designs, so that going back to a filter that was already
+//	designed (sweeping fc up and down, switching between presets) copies nothing and designs nothing.
+//	Entries are matched on the whole FIRDesignSpec and the least recently used one is replaced on a miss.  There are
+//	only a handful of entries, so they are searched linearly.  All of the memory is allocated when the cache is created
+typedef struct
+{
+	FIRDesignCacheEntry *entries;
+	size_t numEntries;
+	uint32_t maxTaps;
+	uint32_t clock;				//	Counts lookups, for lastUsed
+	uint32_t hits;
+	uint32_t misses;
+}FIRDesignCache;
+
+
+FIRDesignCache		*createFIRDesignCache(size_t numEntries, uint32_t maxTaps);
+void				deleteFIRDesignCache(FIRDesignCache *c);
+void				firDesignCacheClear(FIRDesignCache *c);
+const float32_t		*firDesignCacheGet(FIRDesignCache *c, const FIRDesignSpec *spec);
+
+
+#endif /* SRC_FIRDESIGNCACHE_H_ */
@@ -0,0 +1,490 @@
+/*
+ * FIRFilter.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FIRFilter.h"
+#include "string.h"
+
+
+//	Returns the smallest power of two that holds numTaps - 1 samples of history and a block of maxBlockSize samples,
+//	or 0 if that is larger than FIR_FILTER_MAX_FFT_SIZE
+size_t firFilterFFTSize(size_t numTaps, size_t maxBlockSize)
+{
+	size_t windowLength = numTaps - 1 + maxBlockSize;
+	size_t fftSize = 32;
+
+	while (fftSize < windowLength)
+		fftSize <<= 1;
+
+	if (fftSize > FIR_FILTER_MAX_FFT_SIZE)
+		return 0;
+
+	return fftSize;
+}
+
+
+//	Compare the multiply-accumulates the direct (or folded) kernel needs for a full block with the estimated cost of one
+//	overlap-save block
+static FIRFilterMode firFilterChooseMode(size_t numTaps, size_t maxBlockSize, int symmetric)
+{
+	size_t fftSize = firFilterFFTSize(numTaps, maxBlockSize);
+	if (fftSize == 0)
+		return FIR_FILTER_DIRECT;
+
+	float32_t taps = symmetric ? (FIR_FILTER_FOLDED_COST * (float32_t)((numTaps + 1) / 2)) : (float32_t)numTaps;
+	float32_t directCost = taps * (float32_t)maxBlockSize;
+	float32_t fftCost = FIR_FILTER_FFT_COST * (float32_t)fftSize * log2f((float32_t)fftSize);
+
+	return (fftCost < directCost) ? FIR_FILTER_FFT : FIR_FILTER_DIRECT;
+}
+
+
+//	h[k] == h[numTaps - 1 - k] for every k
+static int firFilterIsSymmetric(const float32_t *h, size_t numTaps)
+{
+	for (size_t k = 0; k < numTaps / 2; ++k)
+	{
+		if (h[k] != h[numTaps - 1 - k])
+			return 0;
+	}
+
+	return 1;
+}
+
+
+//	Zero-pad h to fftSize and put its spectrum in spectrum, using updateBuffer as the FFT input
+static void firFilterTransform(FIRFilter *f, const float32_t *h, float32_t *spectrum)
+{
+	arm_fill_f32(0.f, f->updateBuffer, f->fftSize);
+	arm_copy_f32((float32_t *)h, f->updateBuffer, f->numTaps);
+	arm_rfft_fast_f32(&f->fft, f->updateBuffer, spectrum, 0);
+}
+
+
+//	The FFT scratch, the update scratch and both spectra are allocated as one buffer, in that order
+static int firFilterInitFFT(FIRFilter *f, const float32_t *h)
+{
+	f->fftSize = firFilterFFTSize(f->numTaps, f->maxBlockSize);
+	if (f->fftSize == 0)
+		return -1;
+
+	if (arm_rfft_fast_init_f32(&f->fft, (uint16_t)f->fftSize) != ARM_MATH_SUCCESS)
+		return -1;
+
+	f->fftBuffer = (float32_t *)malloc(sizeof(float32_t) * 5 * f->fftSize);
+	if (f->fftBuffer == NULL)
+		return -1;
+
+	f->updateBuffer = f->fftBuffer + (2 * f->fftSize);
+	f->spectrum = f->updateBuffer + f->fftSize;
+	f->nextSpectrum = f->spectrum + f->fftSize;
+
+	firFilterTransform(f, h, f->spectrum);
+
+	return 0;
+}
+
+
+//	Picks the direct kernel or overlap-save with FIR_FILTER_AUTO
+FIRFilter *createFIRFilter(const float32_t *h, size_t numTaps, size_t maxBlockSize)
+{
+	return createFIRFilterWithMode(h, numTaps, maxBlockSize, FIR_FILTER_AUTO);
+}
+
+
+//	The state, the crossfade buffer and both coefficient slots are allocated as one buffer, in that order.
+//	FIR_FILTER_FFT fails if the FFT would have to be larger than FIR_FILTER_MAX_FFT_SIZE
+FIRFilter *createFIRFilterWithMode(const float32_t *h, size_t numTaps, size_t maxBlockSize, FIRFilterMode mode)
+{
+	if ((h == NULL) || (numTaps == 0) || (maxBlockSize == 0))
+		return NULL;
+
+	FIRFilter *f = (FIRFilter *)malloc(sizeof(FIRFilter));
+	if (f == NULL)
+		return NULL;
+
+	f->state = (float32_t *)malloc(sizeof(float32_t) * ((numTaps - 1 + maxBlockSize) + maxBlockSize + (2 * numTaps)));
+	if (f->state == NULL)
+	{
+		free(f);
+		return NULL;
+	}
+
+	f->fadeBuffer = f->state + numTaps - 1 + maxBlockSize;
+	f->coeffs = f->fadeBuffer + maxBlockSize;
+	f->nextCoeffs = f->coeffs + numTaps;
+	f->numTaps = numTaps;
+	f->maxBlockSize = maxBlockSize;
+	f->fftSize = 0;
+	f->spectrum = NULL;
+	f->nextSpectrum = NULL;
+	f->fftBuffer = NULL;
+	f->updateBuffer = NULL;
+	f->nextSymmetric = 0;
+	f->nextFade = 0;
+	f->updateSequence = 0;
+	f->appliedSequence = 0;
+
+	//	Reversed, so that the oldest sample in the window lines up with the last coefficient
+	for (size_t k = 0; k < numTaps; ++k)
+		f->coeffs[k] = h[numTaps - 1 - k];
+
+	f->symmetric = firFilterIsSymmetric(h, numTaps);
+
+	if (mode == FIR_FILTER_AUTO)
+		mode = firFilterChooseMode(numTaps, maxBlockSize, f->symmetric);
+
+	f->mode = mode;
+
+	if ((mode == FIR_FILTER_FFT) && (firFilterInitFFT(f, h) < 0))
+	{
+		deleteFIRFilter(f);
+		return NULL;
+	}
+
+	firFilterReset(f);
+
+	return f;
+}
+
+
+void deleteFIRFilter(FIRFilter *f)
+{
+	if (f == NULL) return;
+
+	if (f->state != NULL)
+	{
+		free(f->state);
+		f->state = NULL;
+		f->fadeBuffer = NULL;
+		f->coeffs = NULL;
+		f->nextCoeffs = NULL;
+	}
+
+	if (f->fftBuffer != NULL)
+	{
+		free(f->fftBuffer);
+		f->fftBuffer = NULL;
+		f->updateBuffer = NULL;
+		f->spectrum = NULL;
+		f->nextSpectrum = NULL;
+	}
+
+	free(f);
+	f = NULL;
+
+	return;
+}
+
+
+//	Hand a new set of numTaps coefficients to the audio thread.  Called from the control thread or an interrupt (only
+//	one context may call it), never blocks and never allocates.  h is reversed (and transformed in FFT mode) into the
+//	inactive slot and published; the next firFilterProcessBlock() switches to it at the start of its block, crossfading
+//	from the old set's output to the new one's over that call if crossfade is set.
+//	Returns -1 without changing anything if the last set hasn't been picked up yet, so try again after the next block
+int firFilterSetCoefficients(FIRFilter *f, const float32_t *h, int crossfade)
+{
+	if ((f == NULL) || (h == NULL)) return -1;
+
+	uint32_t sequence = f->updateSequence;
+	if (sequence != f->appliedSequence) return -1;
+
+	//	The audio thread has finished with the inactive slot by the time it acknowledges the last set
+	__DMB();
+
+	for (size_t k = 0; k < f->numTaps; ++k)
+		f->nextCoeffs[k] = h[f->numTaps - 1 - k];
+
+	f->nextSymmetric = firFilterIsSymmetric(h, f->numTaps);
+	f->nextFade = crossfade;
+
+	if (f->mode == FIR_FILTER_FFT)
+		firFilterTransform(f, h, f->nextSpectrum);
+
+	//	The whole set has to be visible before the audio thread can see the new sequence number
+	__DMB();
+	f->updateSequence = sequence + 1;
+
+	return 0;
+}
+
+
+//	Clear the filter's history back to silence
+void firFilterReset(FIRFilter *f)
+{
+	if (f == NULL) return;
+
+	arm_fill_f32(0.f, f->state, f->numTaps - 1 + f->maxBlockSize);
+
+	return;
+}
+
+
+//	y[i] = sum of h[k] * s[i + k] for count outputs.  Outputs are computed four at a time so that each coefficient is
+//	loaded once per group and the state samples slide through registers
+static void firFilterDirect(const float32_t *h, size_t numTaps, const float32_t *state, float32_t *y, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const float32_t *s = state + i;
+		float32_t acc0 = 0.f;
+		float32_t acc1 = 0.f;
+		float32_t acc2 = 0.f;
+		float32_t acc3 = 0.f;
+		float32_t s0 = s[0];
+		float32_t s1 = s[1];
+		float32_t s2 = s[2];
+
+		for (size_t k = 0; k < numTaps; ++k)
+		{
+			float32_t c = h[k];
+			float32_t s3 = s[k + 3];
+
+			acc0 += c * s0;
+			acc1 += c * s1;
+			acc2 += c * s2;
+			acc3 += c * s3;
+
+			s0 = s1;
+			s1 = s2;
+			s2 = s3;
+		}
+
+		y[i] = acc0;
+		y[i + 1] = acc1;
+		y[i + 2] = acc2;
+		y[i + 3] = acc3;
+	}
+
+	for (; i < count; ++i)
+	{
+		const float32_t *s = state + i;
+		float32_t acc = 0.f;
+
+		for (size_t k = 0; k < numTaps; ++k)
+			acc += h[k] * s[k];
+
+		y[i] = acc;
+	}
+}
+
+
+//	Same as firFilterDirect() for an even-symmetric h: s[i + k] and s[i + numTaps - 1 - k] are added before they are
+//	multiplied by h[k], and an odd numTaps leaves the middle tap on its own.  With SSE, eight outputs are computed per
+//	group as two vectors of four neighbouring outputs, so the pre-adds are plain unaligned loads and no shuffles are
+//	needed.  Without it, outputs are computed four at a time as in firFilterDirect()
+static void firFilterFolded(const float32_t *h, size_t numTaps, const float32_t *state, float32_t *y, size_t count)
+{
+	size_t half = numTaps / 2;
+	size_t last = numTaps - 1;
+	int odd = (int)(numTaps & 1);
+	size_t i = 0;
+
+#if defined(__SSE__) || defined(_M_X64)
+	for (; i + 8 <= count; i += 8)
+	{
+		const float32_t *s = state + i;
+		__m128 acc0 = _mm_setzero_ps();
+		__m128 acc1 = _mm_setzero_ps();
+
+		for (size_t k = 0; k < half; ++k)
+		{
+			__m128 c = _mm_set1_ps(h[k]);
+			__m128 pair0 = _mm_add_ps(_mm_loadu_ps(s + k), _mm_loadu_ps(s + last - k));
+			__m128 pair1 = _mm_add_ps(_mm_loadu_ps(s + k + 4), _mm_loadu_ps(s + last - k + 4));
+
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(c, pair0));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(c, pair1));
+		}
+
+		if (odd)
+		{
+			__m128 c = _mm_set1_ps(h[half]);
+			acc0 = _mm_add_ps(acc0, _mm_mul_ps(c, _mm_loadu_ps(s + half)));
+			acc1 = _mm_add_ps(acc1, _mm_mul_ps(c, _mm_loadu_ps(s + half + 4)));
+		}
+
+		_mm_storeu_ps(y + i, acc0);
+		_mm_storeu_ps(y + i + 4, acc1);
+	}
+#else
+	for (; i + 4 <= count; i += 4)
+	{
+		const float32_t *s = state + i;
+		float32_t acc0 = 0.f;
+		float32_t acc1 = 0.f;
+		float32_t acc2 = 0.f;
+		float32_t acc3 = 0.f;
+
+		for (size_t k = 0; k < half; ++k)
+		{
+			float32_t c = h[k];
+			const float32_t *a = s + k;
+			const float32_t *b = s + last - k;
+
+			acc0 += c * (a[0] + b[0]);
+			acc1 += c * (a[1] + b[1]);
+			acc2 += c * (a[2] + b[2]);
+			acc3 += c * (a[3] + b[3]);
+		}
+
+		if (odd)
+		{
+			float32_t c = h[half];
+			acc0 += c * s[half];
+			acc1 += c * s[half + 1];
+			acc2 += c * s[half + 2];
+			acc3 += c * s[half + 3];
+		}
+
+		y[i] = acc0;
+		y[i + 1] = acc1;
+		y[i + 2] = acc2;
+		y[i + 3] = acc3;
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const float32_t *s = state + i;
+		float32_t acc = odd ? (h[half] * s[half]) : 0.f;
+
+		for (size_t k = 0; k < half; ++k)
+			acc += h[k] * (s[k] + s[last - k]);
+
+		y[i] = acc;
+	}
+}
+
+
+//	Overlap-save for count outputs.  The window is the numTaps - 1 + count samples at the start of the state buffer,
+//	placed at the end of the FFT input so that the outputs that are kept are the last count samples of the result
+static void firFilterFFT(FIRFilter *f, const float32_t *spectrum, float32_t *y, size_t count)
+{
+	size_t fftSize = f->fftSize;
+	size_t windowLength = f->numTaps - 1 + count;
+	float32_t *in = f->fftBuffer;
+	float32_t *out = f->fftBuffer + fftSize;
+
+	arm_fill_f32(0.f, in, fftSize - windowLength);
+	arm_copy_f32(f->state, in + fftSize - windowLength, windowLength);
+
+	arm_rfft_fast_f32(&f->fft, in, out, 0);
+
+	//	DC and Nyquist are both real and packed into the first two floats, the rest are complex pairs
+	out[0] *= spectrum[0];
+	out[1] *= spectrum[1];
+	arm_cmplx_mult_cmplx_f32(out + 2, (float32_t *)spectrum + 2, out + 2, (fftSize / 2) - 1);
+
+	arm_rfft_fast_f32(&f->fft, out, in, 1);
+
+	arm_copy_f32(in + fftSize - count, y, count);
+}
+
+
+//	Filter count samples out of the state buffer with one of the two coefficient sets
+static void firFilterRun(FIRFilter *f, const float32_t *coeffs, int symmetric, const float32_t *spectrum, float32_t *y, size_t count)
+{
+	if (f->mode == FIR_FILTER_FFT)
+		firFilterFFT(f, spectrum, y, count);
+	else if (symmetric)
+		firFilterFolded(coeffs, f->numTaps, f->state, y, count);
+	else
+		firFilterDirect(coeffs, f->numTaps, f->state, y, count);
+}
+
+
+//	Make the published set the active one.  The old set moves to the inactive slot, where the crossfade still reads it
+static void firFilterSwapCoefficients(FIRFilter *f)
+{
+	float32_t *coeffs = f->coeffs;
+	int symmetric = f->symmetric;
+	float32_t *spectrum = f->spectrum;
+
+	f->coeffs = f->nextCoeffs;
+	f->symmetric = f->nextSymmetric;
+	f->spectrum = f->nextSpectrum;
+
+	f->nextCoeffs = coeffs;
+	f->nextSymmetric = symmetric;
+	f->nextSpectrum = spectrum;
+}
+
+
+//	y = from + g * (y - from), with g going linearly from (position + 1) / length up to 1 at the end of the fade
+static void firFilterCrossfade(const float32_t *from, float32_t *y, size_t count, size_t position, size_t length)
+{
+	float32_t step = 1.f / (float32_t)length;
+	float32_t g = (float32_t)(position + 1) * step;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		y[i] = from[i] + (g * (y[i] - from[i]));
+		g += step;
+	}
+}
+
+
+//	Filter a block of n samples.  Blocks longer than maxBlockSize are processed maxBlockSize samples at a time.
+//	A coefficient set published by firFilterSetCoefficients() is switched to at the start of the call, and a crossfade
+//	runs over all n samples.  x and y may point to the same buffer
+int firFilterProcessBlock(FIRFilter *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	size_t numTaps = f->numTaps;
+	size_t fadeLength = n;
+	size_t fadePosition = 0;
+	int fade = 0;
+
+	uint32_t sequence = f->updateSequence;
+	int update = (sequence != f->appliedSequence);
+
+	if (update)
+	{
+		__DMB();
+		firFilterSwapCoefficients(f);
+		fade = f->nextFade;
+	}
+
+	while (n > 0)
+	{
+		size_t count = (n < f->maxBlockSize) ? n : f->maxBlockSize;
+
+		//	The new samples go in behind the history, so the window for output i starts at state[i]
+		memcpy(f->state + numTaps - 1, x, sizeof(float32_t) * count);
+
+		//	The old set's output goes in fadeBuffer before x is overwritten, in case y is x
+		if (fade)
+			firFilterRun(f, f->nextCoeffs, f->nextSymmetric, f->nextSpectrum, f->fadeBuffer, count);
+
+		firFilterRun(f, f->coeffs, f->symmetric, f->spectrum, y, count);
+
+		if (fade)
+		{
+			firFilterCrossfade(f->fadeBuffer, y, count, fadePosition, fadeLength);
+			fadePosition += count;
+		}
+
+		//	Keep the last numTaps - 1 inputs as the history for the next block
+		memmove(f->state, f->state + count, sizeof(float32_t) * (numTaps - 1));
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	//	Only now is the old set free for the control thread to overwrite
+	if (update)
+	{
+		__DMB();
+		f->appliedSequence = sequence;
+	}
+
+	return 0;
+}
+
+
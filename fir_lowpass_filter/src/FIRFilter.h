@@ -0,0 +1,100 @@
+/*
+ * FIRFilter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FIRFILTER_H_
+#define SRC_FIRFILTER_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include "xmmintrin.h"
+#endif
+
+
+//	Largest FFT arm_rfft_fast_f32 supports
+#define FIR_FILTER_MAX_FFT_SIZE 4096
+
+//	Rough cost of one overlap-save block (two real FFTs and the spectrum multiply) in multiply-accumulates of the
+//	direct kernel per fftSize * log2(fftSize), and of one tap pair of the folded kernel in the same units.
+//	FIR_FILTER_AUTO picks the FFT when it is cheaper than the direct or folded kernel for a full block.  On the Cortex-M4
+//	both kernels are scalar and a folded pair costs about one multiply-accumulate, which with 512 sample blocks puts the
+//	crossover at about 100 taps (200 for symmetric filters).  On x86 the folded kernel is vectorized and the direct one
+//	isn't, and the values come from bench_fir: the crossover is at about 120 taps, and at about 400 for symmetric filters
+#if defined(__SSE__) || defined(_M_X64)
+#ifndef FIR_FILTER_FFT_COST
+#define FIR_FILTER_FFT_COST 6.f
+#endif
+#ifndef FIR_FILTER_FOLDED_COST
+#define FIR_FILTER_FOLDED_COST 0.6f
+#endif
+#else
+#ifndef FIR_FILTER_FFT_COST
+#define FIR_FILTER_FFT_COST 5.f
+#endif
+#ifndef FIR_FILTER_FOLDED_COST
+#define FIR_FILTER_FOLDED_COST 1.f
+#endif
+#endif
+
+
+typedef enum
+{
+	FIR_FILTER_AUTO = 0,		//	Whichever of the two is cheaper for numTaps and maxBlockSize
+	FIR_FILTER_DIRECT,
+	FIR_FILTER_FFT
+}FIRFilterMode;
+
+
+//	Block FIR filter with its own history, so that more than one filter can run at a time.
+//	The state buffer holds the last numTaps - 1 input samples followed by room for maxBlockSize new ones, the same
+//	layout arm_fir_f32 uses.  Each block is copied in behind the history, every output is then a contiguous dot product
+//	of the reversed coefficients with the state, and the history is moved to the front once at the end of the block.
+//	Even-symmetric (linear-phase) impulse responses such as the ones fir_calculateLPFCoefficients() designs are
+//	detected when the filter is created and run through a folded kernel: the two samples that share a coefficient are
+//	added first, so only the first (numTaps + 1) / 2 coefficients are multiplied.
+//	Long filters are run with FFT overlap-save instead.  The FFT window is the smallest power of two that holds the
+//	history plus one block, so every call still produces its outputs straight away from the same state buffer: the
+//	history and the new block are zero-padded to fftSize, multiplied with the precomputed spectrum of h and transformed
+//	back, and the last n outputs (the ones that didn't wrap around) are kept.
+//	The coefficients can be changed while the filter runs.  There are two coefficient slots: the audio thread reads the
+//	active one, firFilterSetCoefficients() fills the inactive one and publishes it by bumping updateSequence, and
+//	firFilterProcessBlock() swaps the slots at the start of its next block and acknowledges the set through
+//	appliedSequence when the block is done.  A new set is refused until the last one has been acknowledged, so neither
+//	side ever touches a slot the other one is using and the audio thread never waits
+typedef struct
+{
+	float32_t *coeffs;			//	h[numTaps - 1] ... h[0], active slot
+	float32_t *state;			//	numTaps - 1 + maxBlockSize samples
+	size_t numTaps;
+	size_t maxBlockSize;
+	int symmetric;				//	h[k] == h[numTaps - 1 - k] for every k
+	FIRFilterMode mode;			//	FIR_FILTER_DIRECT or FIR_FILTER_FFT
+	size_t fftSize;
+	arm_rfft_fast_instance_f32 fft;
+	float32_t *spectrum;		//	Spectrum of h in arm_rfft_fast_f32's packed format, fftSize floats
+	float32_t *fftBuffer;		//	2 * fftSize floats of scratch
+	float32_t *nextCoeffs;		//	Inactive slot
+	int nextSymmetric;
+	float32_t *nextSpectrum;
+	float32_t *updateBuffer;	//	fftSize floats of scratch for firFilterSetCoefficients()
+	float32_t *fadeBuffer;		//	Old set's output during a crossfade, maxBlockSize
+	int nextFade;				//	Crossfade into the published set
+	volatile uint32_t updateSequence;
+	volatile uint32_t appliedSequence;
+}FIRFilter;
+
+
+FIRFilter	*createFIRFilter(const float32_t *h, size_t numTaps, size_t maxBlockSize);
+FIRFilter	*createFIRFilterWithMode(const float32_t *h, size_t numTaps, size_t maxBlockSize, FIRFilterMode mode);
+size_t		firFilterFFTSize(size_t numTaps, size_t maxBlockSize);
+void		deleteFIRFilter(FIRFilter *f);
+int			firFilterSetCoefficients(FIRFilter *f, const float32_t *h, int crossfade);
+void		firFilterReset(FIRFilter *f);
+int			firFilterProcessBlock(FIRFilter *f, const float32_t *x, float32_t *y, size_t n);
+
+
+#endif /* SRC_FIRFILTER_H_ */
@@ -0,0 +1,266 @@
+/*
+ * FIRFilterQ15.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FIRFilterQ15.h"
+#include "string.h"
+
+
+//	The coefficients and the state are allocated as one buffer, coefficients first.  Returns NULL if h holds -32768
+FIRFilterQ15 *createFIRFilterQ15(const q15_t *h, size_t numTaps, size_t maxBlockSize)
+{
+	if ((h == NULL) || (numTaps == 0) || (maxBlockSize == 0))
+		return NULL;
+
+	int64_t sumAbs = 0;
+	for (size_t k = 0; k < numTaps; ++k)
+	{
+		if (h[k] == -32768)
+			return NULL;
+
+		sumAbs += (h[k] < 0) ? -(int64_t)h[k] : (int64_t)h[k];
+	}
+
+	FIRFilterQ15 *f = (FIRFilterQ15 *)malloc(sizeof(FIRFilterQ15));
+	if (f == NULL)
+		return NULL;
+
+	size_t paddedTaps = ((numTaps + FIR_Q15_TAP_MULTIPLE - 1) / FIR_Q15_TAP_MULTIPLE) * FIR_Q15_TAP_MULTIPLE;
+
+	f->coeffs = (q15_t *)malloc(sizeof(q15_t) * (paddedTaps + paddedTaps - 1 + maxBlockSize));
+	if (f->coeffs == NULL)
+	{
+		free(f);
+		return NULL;
+	}
+
+	f->state = f->coeffs + paddedTaps;
+	f->numTaps = paddedTaps;
+	f->maxBlockSize = maxBlockSize;
+	f->narrow = (sumAbs < 65536);
+
+	//	Reversed like FIRFilter, with the padding in front so that it lines up with the oldest samples
+	size_t padding = paddedTaps - numTaps;
+	for (size_t k = 0; k < padding; ++k)
+		f->coeffs[k] = 0;
+
+	for (size_t k = 0; k < numTaps; ++k)
+		f->coeffs[padding + k] = h[numTaps - 1 - k];
+
+	firFilterQ15Reset(f);
+
+	return f;
+}
+
+
+void deleteFIRFilterQ15(FIRFilterQ15 *f)
+{
+	if (f == NULL) return;
+
+	if (f->coeffs != NULL)
+	{
+		free(f->coeffs);
+		f->coeffs = NULL;
+		f->state = NULL;
+	}
+
+	free(f);
+	f = NULL;
+
+	return;
+}
+
+
+void firFilterQ15Reset(FIRFilterQ15 *f)
+{
+	if (f == NULL) return;
+
+	memset(f->state, 0, sizeof(q15_t) * (f->numTaps - 1 + f->maxBlockSize));
+
+	return;
+}
+
+
+//	Q34.30 dot product of numTaps samples and coefficients.  numTaps is a multiple of FIR_Q15_TAP_MULTIPLE
+static inline int64_t firQ15Dot(const q15_t *s, const q15_t *h, size_t numTaps)
+{
+#if defined(__AVX2__)
+	__m256i acc = _mm256_setzero_si256();
+
+	for (size_t k = 0; k < numTaps; k += 16)
+	{
+		__m256i m = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(s + k)), _mm256_loadu_si256((const __m256i *)(h + k)));
+
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(m)));
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(m, 1)));
+	}
+
+	int64_t lanes[4];
+	_mm256_storeu_si256((__m256i *)lanes, acc);
+
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__) || defined(_M_X64)
+	__m128i acc = _mm_setzero_si128();
+
+	//	Sign extended to 64 bits by interleaving with the sign of each pair sum
+	for (size_t k = 0; k < numTaps; k += 8)
+	{
+		__m128i m = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(s + k)), _mm_loadu_si128((const __m128i *)(h + k)));
+		__m128i sign = _mm_srai_epi32(m, 31);
+
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(m, sign));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(m, sign));
+	}
+
+	int64_t lanes[2];
+	_mm_storeu_si128((__m128i *)lanes, acc);
+
+	return lanes[0] + lanes[1];
+#elif defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	uint64_t acc = 0;
+
+	//	Two samples and two coefficients per word.  The Cortex-M4 handles the unaligned loads
+	for (size_t k = 0; k < numTaps; k += 2)
+	{
+		int32_t s2;
+		int32_t h2;
+
+		memcpy(&s2, s + k, sizeof(int32_t));
+		memcpy(&h2, h + k, sizeof(int32_t));
+
+		acc = __SMLALD((uint32_t)s2, (uint32_t)h2, acc);
+	}
+
+	return (int64_t)acc;
+#else
+	int64_t acc = 0;
+
+	for (size_t k = 0; k < numTaps; ++k)
+		acc += (int32_t)s[k] * (int32_t)h[k];
+
+	return acc;
+#endif
+}
+
+
+//	Round a Q34.30 accumulator to Q15 and saturate
+static inline q15_t firQ15Round(int64_t acc)
+{
+	int64_t y = (acc + (1 << 14)) >> 15;
+
+	if (y > 32767)
+		return 32767;
+
+	if (y < -32768)
+		return -32768;
+
+	return (q15_t)y;
+}
+
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+//	Add the four lanes of each accumulator, giving {sum(acc0), sum(acc1), sum(acc2), sum(acc3)}
+static inline __m128i firQ15Reduce4(__m128i acc0, __m128i acc1, __m128i acc2, __m128i acc3)
+{
+	__m128i t01 = _mm_add_epi32(_mm_unpacklo_epi32(acc0, acc1), _mm_unpackhi_epi32(acc0, acc1));
+	__m128i t23 = _mm_add_epi32(_mm_unpacklo_epi32(acc2, acc3), _mm_unpackhi_epi32(acc2, acc3));
+
+	return _mm_add_epi32(_mm_unpacklo_epi64(t01, t23), _mm_unpackhi_epi64(t01, t23));
+}
+#endif
+
+
+//	Filter count samples out of the state buffer.  On x86 a narrow filter computes four outputs at a time in 32-bit lanes,
+//	so that each coefficient vector is loaded once per group, and the four sums are reduced, rounded and saturated
+//	together.  Everything else goes through the 64-bit firQ15Dot()
+static void firQ15Block(const q15_t *state, const q15_t *h, size_t numTaps, int narrow, q15_t *y, size_t count)
+{
+	size_t i = 0;
+
+#if defined(__AVX2__)
+	for (; narrow && (i + 4 <= count); i += 4)
+	{
+		const q15_t *s = state + i;
+		__m256i acc0 = _mm256_setzero_si256();
+		__m256i acc1 = _mm256_setzero_si256();
+		__m256i acc2 = _mm256_setzero_si256();
+		__m256i acc3 = _mm256_setzero_si256();
+
+		for (size_t k = 0; k < numTaps; k += 16)
+		{
+			__m256i c = _mm256_loadu_si256((const __m256i *)(h + k));
+
+			acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(s + k)), c));
+			acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(s + k + 1)), c));
+			acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(s + k + 2)), c));
+			acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(s + k + 3)), c));
+		}
+
+		__m128i sum = firQ15Reduce4(_mm_add_epi32(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1)),
+									_mm_add_epi32(_mm256_castsi256_si128(acc1), _mm256_extracti128_si256(acc1, 1)),
+									_mm_add_epi32(_mm256_castsi256_si128(acc2), _mm256_extracti128_si256(acc2, 1)),
+									_mm_add_epi32(_mm256_castsi256_si128(acc3), _mm256_extracti128_si256(acc3, 1)));
+
+		sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1 << 14)), 15);
+		_mm_storel_epi64((__m128i *)(y + i), _mm_packs_epi32(sum, sum));
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	for (; narrow && (i + 4 <= count); i += 4)
+	{
+		const q15_t *s = state + i;
+		__m128i acc0 = _mm_setzero_si128();
+		__m128i acc1 = _mm_setzero_si128();
+		__m128i acc2 = _mm_setzero_si128();
+		__m128i acc3 = _mm_setzero_si128();
+
+		for (size_t k = 0; k < numTaps; k += 8)
+		{
+			__m128i c = _mm_loadu_si128((const __m128i *)(h + k));
+
+			acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(s + k)), c));
+			acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(s + k + 1)), c));
+			acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(s + k + 2)), c));
+			acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(s + k + 3)), c));
+		}
+
+		__m128i sum = firQ15Reduce4(acc0, acc1, acc2, acc3);
+
+		sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(1 << 14)), 15);
+		_mm_storel_epi64((__m128i *)(y + i), _mm_packs_epi32(sum, sum));
+	}
+#endif
+
+	for (; i < count; ++i)
+		y[i] = firQ15Round(firQ15Dot(state + i, h, numTaps));
+}
+
+
+//	Filter a block of n samples.  Blocks longer than maxBlockSize are processed maxBlockSize samples at a time.
+//	x and y may point to the same buffer
+int firFilterQ15ProcessBlock(FIRFilterQ15 *f, const q15_t *x, q15_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	size_t numTaps = f->numTaps;
+
+	while (n > 0)
+	{
+		size_t count = (n < f->maxBlockSize) ? n : f->maxBlockSize;
+
+		memcpy(f->state + numTaps - 1, x, sizeof(q15_t) * count);
+
+		firQ15Block(f->state, f->coeffs, numTaps, f->narrow, y, count);
+
+		memmove(f->state, f->state + count, sizeof(q15_t) * (numTaps - 1));
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
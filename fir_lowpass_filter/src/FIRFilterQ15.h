@@ -0,0 +1,53 @@
+/*
+ * FIRFilterQ15.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FIRFILTERQ15_H_
+#define SRC_FIRFILTERQ15_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+#if defined(__AVX2__)
+#include "immintrin.h"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include "emmintrin.h"
+#endif
+
+
+//	The tap count is padded with zero taps (at the oldest end) to a multiple of the number of taps one multiply
+//	instruction handles: 16 with AVX2, 8 with SSE2 and 2 with the Cortex-M4's dual 16-bit multiply-accumulate
+#if defined(__AVX2__)
+#define FIR_Q15_TAP_MULTIPLE 16
+#elif defined(__SSE2__) || defined(_M_X64)
+#define FIR_Q15_TAP_MULTIPLE 8
+#else
+#define FIR_Q15_TAP_MULTIPLE 2
+#endif
+
+
+//	Q15 version of FIRFilter for integer sample buffers, with the same state layout.  Products are accumulated in 64 bits
+//	(Q34.30) the way arm_fir_q15 does, with __SMLALD on the Cortex-M4, and the sum is rounded and saturated back to Q15
+//	once at the end, so no input can make the sum wrap.  On x86 pmaddwd adds pairs of products in 32 bits.  When the sum
+//	of |h| is below 2 no partial sum can leave Q2.30, and the outputs are computed four at a time in 32-bit lanes; larger
+//	sets are widened to 64 bits after every pmaddwd.  A coefficient of -32768 is refused, since a pair of them times
+//	-32768 is the one pmaddwd result that doesn't fit
+typedef struct
+{
+	q15_t *coeffs;				//	Reversed and padded, numTaps
+	q15_t *state;				//	numTaps - 1 + maxBlockSize samples
+	size_t numTaps;				//	Padded to a multiple of FIR_Q15_TAP_MULTIPLE
+	size_t maxBlockSize;
+	int narrow;					//	Sum of |h| below 2, so Q2.30 holds every partial sum
+}FIRFilterQ15;
+
+
+FIRFilterQ15	*createFIRFilterQ15(const q15_t *h, size_t numTaps, size_t maxBlockSize);
+void			deleteFIRFilterQ15(FIRFilterQ15 *f);
+void			firFilterQ15Reset(FIRFilterQ15 *f);
+int				firFilterQ15ProcessBlock(FIRFilterQ15 *f, const q15_t *x, q15_t *y, size_t n);
+
+
+#endif /* SRC_FIRFILTERQ15_H_ */
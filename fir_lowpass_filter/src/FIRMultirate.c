@@ -0,0 +1,213 @@
+/*
+ * FIRMultirate.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FIRMultirate.h"
+#include "string.h"
+
+
+static int firMultirateFactorValid(size_t factor)
+{
+	return (factor >= FIR_MULTIRATE_MIN_FACTOR) && (factor <= FIR_MULTIRATE_MAX_FACTOR);
+}
+
+
+//	The coefficients and the state are allocated as one buffer, coefficients first
+FIRDecimator *createFIRDecimator(const float32_t *h, size_t numTaps, size_t factor, size_t maxBlockSize)
+{
+	if ((h == NULL) || (numTaps == 0) || (maxBlockSize == 0) || !firMultirateFactorValid(factor))
+		return NULL;
+
+	FIRDecimator *d = (FIRDecimator *)malloc(sizeof(FIRDecimator));
+	if (d == NULL)
+		return NULL;
+
+	d->coeffs = (float32_t *)malloc(sizeof(float32_t) * (numTaps + numTaps - 1 + maxBlockSize));
+	if (d->coeffs == NULL)
+	{
+		free(d);
+		return NULL;
+	}
+
+	d->state = d->coeffs + numTaps;
+	d->numTaps = numTaps;
+	d->factor = factor;
+	d->maxBlockSize = maxBlockSize;
+
+	for (size_t k = 0; k < numTaps; ++k)
+		d->coeffs[k] = h[numTaps - 1 - k];
+
+	firDecimatorReset(d);
+
+	return d;
+}
+
+
+void deleteFIRDecimator(FIRDecimator *d)
+{
+	if (d == NULL) return;
+
+	if (d->coeffs != NULL)
+	{
+		free(d->coeffs);
+		d->coeffs = NULL;
+		d->state = NULL;
+	}
+
+	free(d);
+	d = NULL;
+
+	return;
+}
+
+
+void firDecimatorReset(FIRDecimator *d)
+{
+	if (d == NULL) return;
+
+	arm_fill_f32(0.f, d->state, d->numTaps - 1 + d->maxBlockSize);
+	d->phase = 0;
+
+	return;
+}
+
+
+//	Decimate a block of n input samples.  The number of outputs written to y (about n / factor, depending on where the
+//	block starts) is returned in numOutputs.  x and y may point to the same buffer
+int firDecimatorProcessBlock(FIRDecimator *d, const float32_t *x, float32_t *y, size_t n, size_t *numOutputs)
+{
+	if ((d == NULL) || (x == NULL) || (y == NULL) || (numOutputs == NULL)) return -1;
+
+	size_t numTaps = d->numTaps;
+	size_t outputs = 0;
+
+	while (n > 0)
+	{
+		size_t count = (n < d->maxBlockSize) ? n : d->maxBlockSize;
+
+		memcpy(d->state + numTaps - 1, x, sizeof(float32_t) * count);
+
+		//	The window for input i starts at state[i], only every factor-th one is computed
+		size_t i = d->phase;
+		for (; i < count; i += d->factor)
+			arm_dot_prod_f32(d->state + i, d->coeffs, numTaps, &y[outputs++]);
+
+		d->phase = i - count;
+
+		memmove(d->state, d->state + count, sizeof(float32_t) * (numTaps - 1));
+
+		x += count;
+		n -= count;
+	}
+
+	*numOutputs = outputs;
+
+	return 0;
+}
+
+
+//	Each sub-filter is padded with zeros up to subLength = ceil(numTaps / factor) taps
+FIRInterpolator *createFIRInterpolator(const float32_t *h, size_t numTaps, size_t factor, size_t maxBlockSize)
+{
+	if ((h == NULL) || (numTaps == 0) || (maxBlockSize == 0) || !firMultirateFactorValid(factor))
+		return NULL;
+
+	FIRInterpolator *p = (FIRInterpolator *)malloc(sizeof(FIRInterpolator));
+	if (p == NULL)
+		return NULL;
+
+	size_t subLength = (numTaps + factor - 1) / factor;
+
+	p->coeffs = (float32_t *)malloc(sizeof(float32_t) * ((factor * subLength) + subLength - 1 + maxBlockSize));
+	if (p->coeffs == NULL)
+	{
+		free(p);
+		return NULL;
+	}
+
+	p->state = p->coeffs + (factor * subLength);
+	p->subLength = subLength;
+	p->factor = factor;
+	p->maxBlockSize = maxBlockSize;
+
+	for (size_t phase = 0; phase < factor; ++phase)
+	{
+		float32_t *sub = p->coeffs + (phase * subLength);
+
+		for (size_t j = 0; j < subLength; ++j)
+		{
+			size_t k = (j * factor) + phase;
+			sub[subLength - 1 - j] = (k < numTaps) ? h[k] : 0.f;
+		}
+	}
+
+	firInterpolatorReset(p);
+
+	return p;
+}
+
+
+void deleteFIRInterpolator(FIRInterpolator *p)
+{
+	if (p == NULL) return;
+
+	if (p->coeffs != NULL)
+	{
+		free(p->coeffs);
+		p->coeffs = NULL;
+		p->state = NULL;
+	}
+
+	free(p);
+	p = NULL;
+
+	return;
+}
+
+
+void firInterpolatorReset(FIRInterpolator *p)
+{
+	if (p == NULL) return;
+
+	arm_fill_f32(0.f, p->state, p->subLength - 1 + p->maxBlockSize);
+
+	return;
+}
+
+
+//	Interpolate a block of n input samples into n * factor output samples.  y must be a different buffer from x and
+//	hold n * factor samples
+int firInterpolatorProcessBlock(FIRInterpolator *p, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((p == NULL) || (x == NULL) || (y == NULL)) return -1;
+	if (x == y) return -1;
+
+	size_t subLength = p->subLength;
+	size_t factor = p->factor;
+
+	while (n > 0)
+	{
+		size_t count = (n < p->maxBlockSize) ? n : p->maxBlockSize;
+
+		memcpy(p->state + subLength - 1, x, sizeof(float32_t) * count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (size_t phase = 0; phase < factor; ++phase)
+				arm_dot_prod_f32(p->state + i, p->coeffs + (phase * subLength), subLength, &y[phase]);
+
+			y += factor;
+		}
+
+		memmove(p->state, p->state + count, sizeof(float32_t) * (subLength - 1));
+
+		x += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
@@ -0,0 +1,58 @@
+/*
+ * FIRMultirate.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FIRMULTIRATE_H_
+#define SRC_FIRMULTIRATE_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+
+#define FIR_MULTIRATE_MIN_FACTOR 2
+#define FIR_MULTIRATE_MAX_FACTOR 8
+
+
+//	Lowpass filter followed by keeping every factor-th sample.  Only the outputs that are kept are computed: the state
+//	buffer is laid out as in FIRFilter and an output is a dot product over the window ending at every factor-th input.
+//	phase carries the position of the next kept sample across blocks, so blocks don't need to be a multiple of factor.
+//	h should have a gain of 1 at DC and cut off below fs / (2 * factor)
+typedef struct
+{
+	float32_t *coeffs;			//	h[numTaps - 1] ... h[0]
+	float32_t *state;			//	numTaps - 1 + maxBlockSize samples
+	size_t numTaps;
+	size_t factor;
+	size_t maxBlockSize;
+	size_t phase;				//	Index in the next block of the first input that produces an output
+}FIRDecimator;
+
+
+//	Zero stuffing by factor followed by a lowpass filter, split into factor polyphase sub-filters so that the stuffed
+//	zeros are never multiplied.  Sub-filter p holds h[p], h[p + factor], h[p + (2 * factor)] ... and produces output
+//	p of every group of factor outputs, all from the same window of input samples.
+//	h should have a gain of factor at DC and cut off below fs / 2 of the input
+typedef struct
+{
+	float32_t *coeffs;			//	factor sub-filters of subLength taps each, reversed like in FIRFilter
+	float32_t *state;			//	subLength - 1 + maxBlockSize input samples
+	size_t subLength;
+	size_t factor;
+	size_t maxBlockSize;
+}FIRInterpolator;
+
+
+FIRDecimator	*createFIRDecimator(const float32_t *h, size_t numTaps, size_t factor, size_t maxBlockSize);
+void			deleteFIRDecimator(FIRDecimator *d);
+void			firDecimatorReset(FIRDecimator *d);
+int				firDecimatorProcessBlock(FIRDecimator *d, const float32_t *x, float32_t *y, size_t n, size_t *numOutputs);
+
+FIRInterpolator	*createFIRInterpolator(const float32_t *h, size_t numTaps, size_t factor, size_t maxBlockSize);
+void			deleteFIRInterpolator(FIRInterpolator *p);
+void			firInterpolatorReset(FIRInterpolator *p);
+int				firInterpolatorProcessBlock(FIRInterpolator *p, const float32_t *x, float32_t *y, size_t n);
+
+
+#endif /* SRC_FIRMULTIRATE_H_ */
@@ -6,12 +6,13 @@
 #include "em_vdac.h"
 #include "arm_math.h"
 
+#include "FIRCoefficients.h"
+#include "FIRFilter.h"
+
 #define NUM_BUFFERS 4
 #define BUFFER_SIZE 512
 #define QUEUE_SIZE (NUM_BUFFERS)
 
-#define NUM_FILTER_COEFFS 9
-
 //  Create buffers
 volatile static float32_t buffer[NUM_BUFFERS][BUFFER_SIZE];
 
@@ -32,12 +33,9 @@ volatile static uint32_t dacQueueTail = QUEUE_SIZE - 1;
 volatile uint32_t adcBufferIndex;
 volatile uint32_t dacBufferIndex;
 
-//	FIR filter parameters
-float32_t v[NUM_FILTER_COEFFS];
-float32_t h[NUM_FILTER_COEFFS];
-float32_t fc = 1000.f;
+//	Sampling rate.  The filter's coefficients are the FIR_LPF_MAIN table in FIRCoefficients.h, designed for this fs
+//	by tools/generate_fir_coefficients.py
 float32_t fs = 40000.f;
-float32_t N = 1024;
 
 
 
@@ -126,72 +124,6 @@ void transferBufferToQueue(volatile float32_t *outgoingBuffer, volatile float32_
 }
 
 
-int fir_calculateLPFCoefficients(float32_t fc, float32_t fs, const float32_t N, const uint32_t nTaps, float32_t *h)
-{
-  if ((h == NULL) ||(fs == 0) || (N == 0))
-    return -1;
-
-  if (nTaps % 2 == 0)
-    return -1;
-
-  float32_t passBandWidth = (2 * (N * fc / fs)) + 1;
-
-  //  Since you can only use positive integers to index arrays, h[k=0] is shifted out to index (nTaps - 1) / 2
-  //  We calculate h(k=0) explicitly here to avoid the divide by zero issues
-  h[(nTaps - 1) / 2] = passBandWidth / N;
-
-  //  Calculate the first (nTaps - 1) / 2 coefficients on the positive k axis
-  int hIndex = ((nTaps - 1) /2) + 1;
-  for (int i = 1; i <= (nTaps - 1) / 2; ++i)
-  {
-    float32_t numerator = arm_sin_f32(PI * i * passBandWidth / N);
-    float32_t denominator = arm_sin_f32(PI * i  / N);
-
-    h[hIndex++] = (1 / N) * (numerator / denominator);
-  }
-
-  //  Copy the calculated coefficients to the other half of the array to get the even symmetry
-  for (int i = 0; i < (nTaps - 1) / 2; ++i)
-    h[i] = h[nTaps - 1 - i];
-
-  return 0;
-}
-
-
-int filterAudioBlock(float32_t *x, size_t bufferSize, float32_t *h, size_t numFilterCoefficients, float32_t *y)
-{
-  //  Some safety checks
-  if ((x == NULL) || (y == NULL))
-    return -1;
-
-  if ((bufferSize == 0) || (numFilterCoefficients == 0))
-  {
-    arm_fill_f32(0.f, y, bufferSize);
-    return 0;
-  }
-
-  for (size_t i = 0; i < bufferSize; ++i)
-  {
-    //  Shift audio samples in v and add shift in new audio sample
-    for (size_t j = numFilterCoefficients - 1; j > 0; --j)
-      v[j] = v[j-1];
-
-    v[0] = x[i];
-
-    //  Multiply and add to get output value
-    float32_t output = 0.f;
-
-    for (size_t j = 0; j < numFilterCoefficients; ++j)
-      output += h[j] * v[j];
-
-    y[i] = output;
-  }
-
-  return 0;
-}
-
-
-
 int main(void)
 {
   /* Chip errata */
@@ -216,10 +148,10 @@ int main(void)
   adcBufferIndex = 0;
   dacBufferIndex = 0;
 
-  int error = fir_calculateLPFCoefficients(fc, fs, N, NUM_FILTER_COEFFS, h);
+  FIRFilter *filter = createFIRFilter(FIR_LPF_MAIN, FIR_LPF_MAIN_NUM_TAPS, BUFFER_SIZE);
 
-    if (error)
-      return error;
+    if (filter == NULL)
+      return -1;
 
   TIMER_Enable(TIMER0, true);
 
@@ -231,7 +163,8 @@ int main(void)
 	  if (processingQueue[processingQueueHead] != NULL)
 	  {
 		  //  Fancy processing code here
-		  filterAudioBlock(processingQueue[processingQueueHead], BUFFER_SIZE, h, NUM_FILTER_COEFFS, processingQueue[processingQueueHead]);
+		  float32_t *block = (float32_t *)processingQueue[processingQueueHead];
+		  firFilterProcessBlock(filter, block, block, BUFFER_SIZE);
 
 	      transferBufferToQueue(processingQueue[processingQueueHead], dacQueue, &dacQueueTail);
 
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# generate_fir_coefficients.py
+#
+#  Created on: Oct 17, 2026
+#
+# Writes a C header with the coefficients of fixed lowpass filters, so that they are const tables in flash instead of
+# being designed at boot.  The designs are the same as the ones in FIRDesign.c, calculated in double precision:
+#
+#   none      fir_calculateLPFCoefficients(), which also needs N
+#   blackman  fir_calculateWindowedLPFCoefficients() with FIR_WINDOW_BLACKMAN
+#   kaiser    fir_calculateWindowedLPFCoefficients() with FIR_WINDOW_KAISER, which also needs beta
+#
+# Each --filter is NAME,fc,fs,nTaps,window[,N or beta].  For example, the filter main.c uses:
+#
+#   python3 generate_fir_coefficients.py -o ../src/FIRCoefficients.h --filter FIR_LPF_MAIN,1000,40000,9,none,1024
+
+import argparse
+import math
+import os
+import sys
+
+
+def besselI0(x):
+    total = 1.0
+    term = 1.0
+    k = 1
+
+    while term > total * 1e-17:
+        term *= (0.5 * x / k) ** 2
+        total += term
+        k += 1
+
+    return total
+
+
+def designFrequencySampled(fc, fs, nTaps, N):
+    if nTaps % 2 == 0:
+        raise ValueError("the frequency-sampled design needs an odd number of taps")
+
+    passBandWidth = (2 * (N * fc / fs)) + 1
+    middle = (nTaps - 1) // 2
+    h = [0.0] * nTaps
+
+    h[middle] = passBandWidth / N
+
+    for i in range(1, middle + 1):
+        h[middle + i] = (1 / N) * (math.sin(math.pi * i * passBandWidth / N) / math.sin(math.pi * i / N))
+        h[middle - i] = h[middle + i]
+
+    return h
+
+
+def designWindowed(fc, fs, nTaps, window, beta):
+    if nTaps < 2 or not (0 < fc < fs / 2):
+        raise ValueError("the windowed design needs at least 2 taps and 0 < fc < fs / 2")
+
+    wc = 2 * fc / fs
+    centre = 0.5 * (nTaps - 1)
+    h = []
+
+    for i in range(nTaps):
+        t = i - centre
+        sinc = wc if t == 0 else math.sin(math.pi * wc * t) / (math.pi * t)
+
+        if window == "blackman":
+            phase = 2 * math.pi * i / (nTaps - 1)
+            w = 0.42 - (0.5 * math.cos(phase)) + (0.08 * math.cos(2 * phase))
+        else:
+            r = t / centre
+            w = besselI0(beta * math.sqrt(max(0.0, 1 - (r * r)))) / besselI0(beta)
+
+        h.append(sinc * w)
+
+    total = sum(h)
+
+    return [c / total for c in h]
+
+
+def parseFilter(text):
+    fields = text.split(",")
+    if len(fields) < 5:
+        raise ValueError("expected NAME,fc,fs,nTaps,window[,N or beta]: " + text)
+
+    name = fields[0]
+    fc = float(fields[1])
+    fs = float(fields[2])
+    nTaps = int(fields[3])
+    window = fields[4].lower()
+
+    if window == "none":
+        if len(fields) != 6:
+            raise ValueError(name + ": the none window needs N")
+        return name, nTaps, designFrequencySampled(fc, fs, nTaps, float(fields[5])), text
+
+    if window == "blackman":
+        return name, nTaps, designWindowed(fc, fs, nTaps, window, 0.0), text
+
+    if window == "kaiser":
+        if len(fields) != 6:
+            raise ValueError(name + ": the kaiser window needs beta")
+        return name, nTaps, designWindowed(fc, fs, nTaps, window, float(fields[5])), text
+
+    raise ValueError(name + ": unknown window " + window)
+
+
+def writeHeader(out, fileName, filters):
+    guard = "SRC_" + os.path.splitext(fileName)[0].upper() + "_H_"
+
+    out.write("/*\n * %s\n *\n * Generated by tools/generate_fir_coefficients.py, don't edit by hand\n */\n\n" % fileName)
+    out.write("#ifndef %s\n#define %s\n\n#include \"arm_math.h\"\n\n" % (guard, guard))
+
+    for name, nTaps, h, text in filters:
+        out.write("\n//\t%s\n" % text)
+        out.write("#define %s_NUM_TAPS %d\n\n" % (name, nTaps))
+        out.write("static const float32_t %s[%s_NUM_TAPS] =\n{\n" % (name, name))
+
+        for i in range(0, nTaps, 4):
+            row = ", ".join("%.9ef" % c for c in h[i:i + 4])
+            out.write("\t%s%s\n" % (row, "," if i + 4 < nTaps else ""))
+
+        out.write("};\n\n")
+
+    out.write("\n#endif /* %s */\n" % guard)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a header of fixed FIR lowpass coefficient tables")
+    parser.add_argument("-o", "--output", help="Header to write, stdout if not given")
+    parser.add_argument("--filter", action="append", required=True, help="NAME,fc,fs,nTaps,window[,N or beta]")
+    args = parser.parse_args()
+
+    try:
+        filters = [parseFilter(f) for f in args.filter]
+    except ValueError as e:
+        sys.exit(str(e))
+
+    if args.output is None:
+        writeHeader(sys.stdout, "FIRCoefficients.h", filters)
+    else:
+        with open(args.output, "w") as out:
+            writeHeader(out, os.path.basename(args.output), filters)
+
+
+if __name__ == "__main__":
+    main()
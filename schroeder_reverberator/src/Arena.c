@@ -0,0 +1,49 @@
+/*
+ * Arena.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "Arena.h"
+
+
+//	memory must be aligned to ARENA_ALIGNMENT so that the sizes returned by the *ArenaSize() functions are exact
+int arenaInit(Arena *a, void *memory, size_t size)
+{
+	if ((a == NULL) || (memory == NULL)) return -1;
+	if (((uintptr_t)memory % ARENA_ALIGNMENT) != 0) return -1;
+
+	a->base = (uint8_t *)memory;
+	a->size = size;
+	a->used = 0;
+
+	return 0;
+}
+
+
+void *arenaAlloc(Arena *a, size_t size)
+{
+	if (a == NULL) return NULL;
+
+	size_t alignedSize = ARENA_ALIGN(size);
+	if (alignedSize > a->size - a->used)
+		return NULL;
+
+	void *p = a->base + a->used;
+	a->used += alignedSize;
+
+	return p;
+}
+
+
+//	Forget every allocation.  Objects that were created in the arena are no longer valid afterwards
+void arenaReset(Arena *a)
+{
+	if (a == NULL) return;
+
+	a->used = 0;
+
+	return;
+}
+
+
@@ -0,0 +1,37 @@
+/*
+ * Arena.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_ARENA_H_
+#define SRC_ARENA_H_
+
+#include "stdint.h"
+#include "stdlib.h"
+
+
+//	Every allocation from an arena starts on an ARENA_ALIGNMENT byte boundary
+#ifndef ARENA_ALIGNMENT
+#define ARENA_ALIGNMENT 8
+#endif
+
+#define ARENA_ALIGN(size) (((size) + (ARENA_ALIGNMENT - 1)) & ~((size_t)ARENA_ALIGNMENT - 1))
+
+
+//	Linear allocator over a block of memory supplied by the caller.  Nothing is freed individually: objects created
+//	in an arena must NOT be passed to the delete functions, the whole arena is released by discarding its memory
+typedef struct
+{
+	uint8_t *base;
+	size_t size;
+	size_t used;
+}Arena;
+
+
+int			arenaInit(Arena *a, void *memory, size_t size);
+void		*arenaAlloc(Arena *a, size_t size);
+void		arenaReset(Arena *a);
+
+
+#endif /* SRC_ARENA_H_ */
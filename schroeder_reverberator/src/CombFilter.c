@@ -64,6 +64,7 @@ APCF *createAPCF(size_t M, float32_t b0, float32_t am)
 	a->fb = createFBCF(M, 1, am);
 	if (a->fb == NULL)
 	{
+		deleteFFCF(a->ff);
 		free(a);
 		return NULL;
 	}
@@ -92,6 +93,75 @@ APCF_T2 *createAPCFT2(size_t M, float32_t b0, float32_t am)
 }
 
 
+FFCF *createFFCFInArena(Arena *arena, size_t M, float32_t b0, float32_t bm)
+{
+	FFCF *f = (FFCF *)arenaAlloc(arena, sizeof(FFCF));
+	if (f == NULL)
+		return NULL;
+
+	f->M = createDelayLineInArena(arena, M);
+	if (f->M == NULL)
+		return NULL;
+
+	f->b0 = b0;
+	f->bm = bm;
+
+	return f;
+}
+
+
+FBCF *createFBCFInArena(Arena *arena, size_t M, float32_t b0, float32_t am)
+{
+	FBCF *f = (FBCF *)arenaAlloc(arena, sizeof(FBCF));
+	if (f == NULL)
+		return NULL;
+
+	f->M = createDelayLineInArena(arena, M);
+	if (f->M == NULL)
+		return NULL;
+
+	f->b0 = b0;
+	f->am = am;
+
+	return f;
+}
+
+
+APCF *createAPCFInArena(Arena *arena, size_t M, float32_t b0, float32_t am)
+{
+	APCF *a = (APCF *)arenaAlloc(arena, sizeof(APCF));
+	if (a == NULL)
+		return NULL;
+
+	a->ff = createFFCFInArena(arena, M, b0, 1);
+	if (a->ff == NULL)
+		return NULL;
+
+	a->fb = createFBCFInArena(arena, M, 1, am);
+	if (a->fb == NULL)
+		return NULL;
+
+	return a;
+}
+
+
+APCF_T2 *createAPCFT2InArena(Arena *arena, size_t M, float32_t b0, float32_t am)
+{
+	APCF_T2 *a = (APCF_T2 *)arenaAlloc(arena, sizeof(APCF_T2));
+	if (a == NULL)
+		return NULL;
+
+	a->M = createDelayLineInArena(arena, M);
+	if (a->M == NULL)
+		return NULL;
+
+	a->b0 = b0;
+	a->am = am;
+
+	return a;
+}
+
+
 void deleteFFCF(FFCF *f)
 {
 	if (f == NULL) return;
@@ -165,7 +235,7 @@ int fbcfShift(FBCF *f, float32_t x, float32_t *y)
 
 	float32_t delayOut = 0;
 	delayLinePeek(f->M, &delayOut);
-	float32_t v = (delayOut * f->am) + x;
+	float32_t v = (delayOut * f->am) + DENORMAL_PROTECT(x);
 	int status = delayLineShift(f->M, v, &delayOut);
 
 	if (status < 0)
@@ -203,7 +273,7 @@ int apcfT2Shift(APCF_T2 *a, float32_t x, float32_t *y)
 	float32_t delayOut = 0;
 	delayLinePeek(a->M, &delayOut);
 
-	float32_t v = (delayOut * a->am) + x;
+	float32_t v = (delayOut * a->am) + DENORMAL_PROTECT(x);
 	*y = (a->b0 * v) + delayOut;
 
 	delayLineShift(a->M, v, &delayOut);
@@ -212,3 +282,172 @@ int apcfT2Shift(APCF_T2 *a, float32_t x, float32_t *y)
 }
 
 
+//	Process a block of n samples through the FFCF.  The block is split at the delay line's wrap point and the
+//	delayed samples of each piece are read straight out of the delay line.  x and y may point to the same buffer
+int ffcfProcessBlock(FFCF *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DelayLine *d = f->M;
+	if (d == NULL) return -1;
+
+	//	Pass-through delay line (M = 0)
+	if (d->M == 0)
+	{
+		arm_scale_f32((float32_t *)x, f->b0 + f->bm, y, n);
+		return 0;
+	}
+
+	if (d->currentPtr >= d->capacity) return -1;
+
+	while (n > 0)
+	{
+		size_t count = delayLineSpan(d, n);
+		float32_t *line = delayLineAcquire(d, count);
+
+		//	y = (b0 * x) + (bm * x[n - M]), then the input replaces the delayed samples
+		if (x != y)
+		{
+			arm_scale_f32(line, f->bm, line, count);
+			arm_scale_f32((float32_t *)x, f->b0, y, count);
+			arm_add_f32(y, line, y, count);
+			arm_copy_f32((float32_t *)x, line, count);
+		}
+
+		//	In-place, the input has to be saved into the delay line before it is overwritten
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				float32_t delayOut = line[i];
+				line[i] = y[i];
+				y[i] = (line[i] * f->b0) + (delayOut * f->bm);
+			}
+		}
+
+		delayLineRelease(d, count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+//	Process a block of n samples through the FBCF.  Each piece of the block is at most M samples long, so every
+//	feedback sample it needs was written before the piece started and the recurrence v = x + (am * v[n - M]) turns
+//	into a plain scale-and-add over the delay line.  x and y may point to the same buffer
+int fbcfProcessBlock(FBCF *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DelayLine *d = f->M;
+	if (d == NULL) return -1;
+
+	//	Pass-through delay line (M = 0), same as fbcfShift()
+	if (d->M == 0)
+	{
+		arm_scale_f32((float32_t *)x, f->b0, y, n);
+		return 0;
+	}
+
+	if (d->currentPtr >= d->capacity) return -1;
+
+	while (n > 0)
+	{
+		size_t count = delayLineSpan(d, n);
+		float32_t *line = delayLineAcquire(d, count);
+
+		arm_scale_f32(line, f->am, line, count);
+		arm_add_f32(line, (float32_t *)x, line, count);
+#if DENORMAL_PROTECTION_DC
+		arm_offset_f32(line, DENORMAL_DC, line, count);
+#endif
+		arm_scale_f32(line, f->b0, y, count);
+
+		delayLineRelease(d, count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+int apcfProcessBlock(APCF *a, const float32_t *x, float32_t *y, size_t n)
+{
+	if (a == NULL) return -1;
+
+	int status = ffcfProcessBlock(a->ff, x, y, n);
+	if (status < 0)
+		return -1;
+
+	return fbcfProcessBlock(a->fb, y, y, n);
+}
+
+
+//	Run a block of n samples through a cascade of APCF_T2 stages in one pass.  The block is split wherever one of the
+//	stages' delay lines wraps, so inside each piece every stage reads and writes its buffer linearly and a sample goes
+//	through all of the stages before the next one is loaded.  x and y may point to the same buffer
+int apcfT2CascadeProcessBlock(APCF_T2 **a, size_t numStages, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((a == NULL) || (x == NULL) || (y == NULL)) return -1;
+	if ((numStages == 0) || (numStages > APCF_T2_CASCADE_MAX_STAGES)) return -1;
+
+	float32_t b0[APCF_T2_CASCADE_MAX_STAGES];
+	float32_t am[APCF_T2_CASCADE_MAX_STAGES];
+	float32_t *line[APCF_T2_CASCADE_MAX_STAGES];
+
+	for (size_t s = 0; s < numStages; ++s)
+	{
+		if ((a[s] == NULL) || (a[s]->M == NULL)) return -1;
+
+		//	Every stage needs a real delay, otherwise the feedback loop has no delay in it
+		if ((a[s]->M->M == 0) || (a[s]->M->currentPtr >= a[s]->M->capacity)) return -1;
+
+		b0[s] = a[s]->b0;
+		am[s] = a[s]->am;
+	}
+
+	while (n > 0)
+	{
+		//	Find the longest piece in which none of the delay lines wrap
+		size_t count = n;
+		for (size_t s = 0; s < numStages; ++s)
+			count = delayLineSpan(a[s]->M, count);
+
+		for (size_t s = 0; s < numStages; ++s)
+			line[s] = delayLineAcquire(a[s]->M, count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			float32_t sample = x[i];
+
+			for (size_t s = 0; s < numStages; ++s)
+			{
+				float32_t delayOut = line[s][i];
+				float32_t v = (delayOut * am[s]) + DENORMAL_PROTECT(sample);
+
+				line[s][i] = v;
+				sample = (b0[s] * v) + delayOut;
+			}
+
+			y[i] = sample;
+		}
+
+		for (size_t s = 0; s < numStages; ++s)
+			delayLineRelease(a[s]->M, count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
@@ -10,9 +10,14 @@
 
 #include "arm_math.h"
 #include "DelayLine.h"
+#include "Arena.h"
+#include "Denormal.h"
 #include "stdlib.h"
 
 
+//	Maximum number of stages apcfT2CascadeProcessBlock() can run in one pass
+#define APCF_T2_CASCADE_MAX_STAGES 8
+
 
 //	Feed-forward Comb Filter
 typedef struct
@@ -39,6 +44,7 @@ typedef struct
 	FBCF *fb;
 }APCF;
 
+//	Allpass Comb Filter (single delay line)
 typedef struct
 {
 	DelayLine *M;
@@ -47,12 +53,24 @@ typedef struct
 }APCF_T2;
 
 
+//	Number of arena bytes used by the create*InArena() functions
+#define FFCF_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(FFCF)) + DELAY_LINE_ARENA_SIZE(M))
+#define FBCF_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(FBCF)) + DELAY_LINE_ARENA_SIZE(M))
+#define APCF_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(APCF)) + FFCF_ARENA_SIZE(M) + FBCF_ARENA_SIZE(M))
+#define APCF_T2_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(APCF_T2)) + DELAY_LINE_ARENA_SIZE(M))
+
+
 
 FFCF		*createFFCF(size_t M, float32_t b0, float32_t bm);
 FBCF		*createFBCF(size_t M, float32_t b0, float32_t am);
 APCF		*createAPCF(size_t M, float32_t b0, float32_t am);
 APCF_T2		*createAPCFT2(size_t M, float32_t b0, float32_t am);
 
+FFCF		*createFFCFInArena(Arena *arena, size_t M, float32_t b0, float32_t bm);
+FBCF		*createFBCFInArena(Arena *arena, size_t M, float32_t b0, float32_t am);
+APCF		*createAPCFInArena(Arena *arena, size_t M, float32_t b0, float32_t am);
+APCF_T2		*createAPCFT2InArena(Arena *arena, size_t M, float32_t b0, float32_t am);
+
 void 		deleteFFCF(FFCF *f);
 void 		deleteFBCF(FBCF *f);
 void 		deleteAPCF(APCF *a);
@@ -63,6 +81,11 @@ int 		fbcfShift(FBCF *f, float32_t x, float32_t *y);
 int 		apcfShift(APCF *a, float32_t x, float32_t *y);
 int			apcfT2Shift(APCF_T2 *a, float32_t x, float32_t *y);
 
+int 		ffcfProcessBlock(FFCF *f, const float32_t *x, float32_t *y, size_t n);
+int 		fbcfProcessBlock(FBCF *f, const float32_t *x, float32_t *y, size_t n);
+int 		apcfProcessBlock(APCF *a, const float32_t *x, float32_t *y, size_t n);
+int			apcfT2CascadeProcessBlock(APCF_T2 **a, size_t numStages, const float32_t *x, float32_t *y, size_t n);
+
 
 
 #endif /* SRC_COMBFILTER_H_ */
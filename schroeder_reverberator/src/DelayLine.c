@@ -6,35 +6,299 @@
  */
 
 #include "DelayLine.h"
+#include "string.h"
+
+
+typedef union
+{
+	float32_t f;
+	uint32_t u;
+}FloatBits;
+
+
+//	Largest finite half precision value
+#define DELAY_LINE_HALF_MAX 65504.f
+
+
+//	Convert to half precision, rounding to nearest even.  Values too large for half precision saturate instead of
+//	becoming inf
+static uint16_t floatToHalf(float32_t x)
+{
+	FloatBits v;
+	v.f = x;
+
+	uint16_t sign = (uint16_t)((v.u >> 16) & 0x8000);
+	int32_t exponent = (int32_t)((v.u >> 23) & 0xFF) - 127 + 15;
+	uint32_t mantissa = v.u & 0x7FFFFF;
+	uint32_t shift = 13;
+
+	if (exponent >= 31)
+		return sign | 0x7BFF;
+
+	//	Subnormal (or zero) in half precision, the implicit 1 is shifted out with the bits that don't fit
+	if (exponent <= 0)
+	{
+		if (exponent < -10)
+			return sign;
+
+		mantissa |= 0x800000;
+		shift = (uint32_t)(14 - exponent);
+		exponent = 0;
+	}
+
+	uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> shift);
+	uint32_t rest = mantissa & ((1UL << shift) - 1);
+	uint32_t halfway = 1UL << (shift - 1);
+
+	//	A carry out of the mantissa moves the exponent up, which is still the right value
+	if ((rest > halfway) || ((rest == halfway) && (half & 1)))
+		++half;
+
+	if (half > 0x7BFF)
+		half = 0x7BFF;
+
+	return sign | (uint16_t)half;
+}
+
+
+static float32_t halfToFloat(uint16_t h)
+{
+	uint32_t sign = ((uint32_t)h & 0x8000) << 16;
+	uint32_t exponent = (h >> 10) & 0x1F;
+	uint32_t mantissa = h & 0x3FF;
+
+	FloatBits v;
+
+	//	Subnormal (or zero): mantissa * 2^-24
+	if (exponent == 0)
+	{
+		v.f = (float32_t)mantissa * 5.9604645e-8f;
+		v.u |= sign;
+
+		return v.f;
+	}
+
+	v.u = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+	return v.f;
+}
+
+
+//	Half precision block converters.  F16C on x86 and VCVTB on the Cortex-M4F (through __fp16, which needs
+//	-mfp16-format=ieee) convert in hardware and round to nearest even, the same as the bit manipulation they fall back to.
+//	Values are clamped to DELAY_LINE_HALF_MAX first so that they saturate there rather than becoming inf
+static void delayLineFloatToHalf(const float32_t *src, uint16_t *dst, size_t n)
+{
+	size_t i = 0;
+
+#if defined(__F16C__)
+	const __m256 high = _mm256_set1_ps(DELAY_LINE_HALF_MAX);
+	const __m256 low = _mm256_set1_ps(-DELAY_LINE_HALF_MAX);
+
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), low), high);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+	}
+#elif defined(__ARM_FP16_FORMAT_IEEE)
+	__fp16 *h = (__fp16 *)dst;
+
+	for (; i < n; ++i)
+	{
+		float32_t v = src[i];
+		v = (v > DELAY_LINE_HALF_MAX) ? DELAY_LINE_HALF_MAX : ((v < -DELAY_LINE_HALF_MAX) ? -DELAY_LINE_HALF_MAX : v);
+		h[i] = (__fp16)v;
+	}
+#endif
+
+	for (; i < n; ++i)
+		dst[i] = floatToHalf(src[i]);
+}
+
+
+static void delayLineHalfToFloat(const uint16_t *src, float32_t *dst, size_t n)
+{
+	size_t i = 0;
+
+#if defined(__F16C__)
+	for (; i + 8 <= n; i += 8)
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i))));
+#elif defined(__ARM_FP16_FORMAT_IEEE)
+	const __fp16 *h = (const __fp16 *)src;
+
+	for (; i < n; ++i)
+		dst[i] = (float32_t)h[i];
+#endif
+
+	for (; i < n; ++i)
+		dst[i] = halfToFloat(src[i]);
+}
+
+
+//	Block converters between the float scratch buffer and compact storage
+static void delayLineLoad(DelayLine *d, size_t offset, float32_t *dst, size_t n)
+{
+	if (d->format == DELAY_LINE_FORMAT_Q15)
+	{
+		arm_q15_to_float((q15_t *)d->samples + offset, dst, n);
+		arm_scale_f32(dst, d->fullScale, dst, n);
+	}
+	else
+		delayLineHalfToFloat((const uint16_t *)d->samples + offset, dst, n);
+}
+
+
+//	src is used as scratch space and is overwritten
+static void delayLineStore(DelayLine *d, size_t offset, float32_t *src, size_t n)
+{
+	if (d->format == DELAY_LINE_FORMAT_Q15)
+	{
+		arm_scale_f32(src, 1.f / d->fullScale, src, n);
+		arm_float_to_q15(src, (q15_t *)d->samples + offset, n);
+	}
+	else
+		delayLineFloatToHalf(src, (uint16_t *)d->samples + offset, n);
+}
+
+
+//	Set up a DelayLine whose memory has already been allocated.  For DELAY_LINE_FORMAT_F32, buffer holds M samples and
+//	samples is unused.  For compact formats, samples holds M 16-bit samples and buffer holds DELAY_LINE_SCRATCH_SIZE floats
+int delayLineInit(DelayLine *d, size_t M, DelayLineFormat format, float32_t fullScale, float32_t *buffer, void *samples)
+{
+	if (d == NULL) return -1;
+	if ((format != DELAY_LINE_FORMAT_F32) && (format != DELAY_LINE_FORMAT_Q15) && (format != DELAY_LINE_FORMAT_F16)) return -1;
+	if ((format == DELAY_LINE_FORMAT_Q15) && (fullScale <= 0.f)) return -1;
+
+	d->M = M;
+	d->capacity = M;
+	d->currentPtr = 0;
+	d->format = format;
+	d->fullScale = fullScale;
+	d->buffer = buffer;
+	d->samples = samples;
+
+	if (M == 0)
+		return 0;
+
+	if (format == DELAY_LINE_FORMAT_F32)
+	{
+		if (buffer == NULL) return -1;
+
+		d->samples = NULL;
+		arm_fill_f32(0.f, d->buffer, M);
+	}
+	else
+	{
+		if ((buffer == NULL) || (samples == NULL)) return -1;
+
+		//	0 is all bits clear in both Q15 and half precision
+		memset(d->samples, 0, M * sizeof(uint16_t));
+	}
+
+	return 0;
+}
 
 
 DelayLine *createDelayLine(size_t M)
+{
+	return createDelayLineWithFormat(M, DELAY_LINE_FORMAT_F32, 1.f);
+}
+
+
+//	fullScale is only used by DELAY_LINE_FORMAT_Q15 and should be the largest magnitude the delay line has to hold
+DelayLine *createDelayLineWithFormat(size_t M, DelayLineFormat format, float32_t fullScale)
 {
 	DelayLine *d = (DelayLine *)malloc(sizeof(DelayLine));
 	if (d == NULL)
 		return NULL;
 
+	float32_t *buffer = NULL;
+	void *samples = NULL;
+
 	if (M != 0)
 	{
-		d->buffer = (float *)malloc(sizeof(float) * M);
-		if (d->buffer == NULL)
+		size_t bufferLength = (format == DELAY_LINE_FORMAT_F32) ? M : DELAY_LINE_SCRATCH_SIZE;
+
+		buffer = (float32_t *)malloc(sizeof(float32_t) * bufferLength);
+		if (buffer == NULL)
 		{
 			free(d);
 			return NULL;
 		}
 
-		arm_fill_f32(0.f, d->buffer, M);
+		if (format != DELAY_LINE_FORMAT_F32)
+		{
+			samples = malloc(sizeof(uint16_t) * M);
+			if (samples == NULL)
+			{
+				free(buffer);
+				free(d);
+				return NULL;
+			}
+		}
 	}
-	else
-		d->buffer = NULL;
 
-	d->M = M;
-	d->currentPtr = 0;
+	if (delayLineInit(d, M, format, fullScale, buffer, samples) < 0)
+	{
+		free(samples);
+		free(buffer);
+		free(d);
+		return NULL;
+	}
 
 	return d;
 }
 
 
+//	Same as createDelayLine() but the DelayLine and its buffer are placed in the arena
+DelayLine *createDelayLineInArena(Arena *a, size_t M)
+{
+	return createDelayLineWithFormatInArena(a, M, DELAY_LINE_FORMAT_F32, 1.f);
+}
+
+
+DelayLine *createDelayLineWithFormatInArena(Arena *a, size_t M, DelayLineFormat format, float32_t fullScale)
+{
+	DelayLine *d = (DelayLine *)arenaAlloc(a, sizeof(DelayLine));
+	if (d == NULL)
+		return NULL;
+
+	float32_t *buffer = NULL;
+	void *samples = NULL;
+
+	if (M != 0)
+	{
+		if (format == DELAY_LINE_FORMAT_F32)
+			buffer = (float32_t *)arenaAlloc(a, sizeof(float32_t) * M);
+		else
+		{
+			samples = arenaAlloc(a, sizeof(uint16_t) * M);
+			buffer = (float32_t *)arenaAlloc(a, sizeof(float32_t) * DELAY_LINE_SCRATCH_SIZE);
+		}
+	}
+
+	if ((M != 0) && (buffer == NULL))
+		return NULL;
+
+	if (delayLineInit(d, M, format, fullScale, buffer, samples) < 0)
+		return NULL;
+
+	return d;
+}
+
+
+size_t delayLineArenaSize(size_t M, DelayLineFormat format)
+{
+	if (M == 0)
+		return ARENA_ALIGN(sizeof(DelayLine));
+
+	if (format == DELAY_LINE_FORMAT_F32)
+		return DELAY_LINE_ARENA_SIZE(M);
+
+	return DELAY_LINE_COMPACT_ARENA_SIZE(M);
+}
+
+
 void deleteDelayLine(DelayLine *d)
 {
 	if (d == NULL)
@@ -46,6 +310,12 @@ void deleteDelayLine(DelayLine *d)
 		d->buffer = NULL;
 	}
 
+	if (d->samples != NULL)
+	{
+		free(d->samples);
+		d->samples = NULL;
+	}
+
 	free(d);
 	d = NULL;
 
@@ -53,21 +323,96 @@ void deleteDelayLine(DelayLine *d)
 }
 
 
+//	Clear the delay line back to silence without reallocating it
+void delayLineReset(DelayLine *d)
+{
+	if (d == NULL) return;
+
+	d->currentPtr = 0;
+
+	if (d->capacity == 0)
+		return;
+
+	if (d->format == DELAY_LINE_FORMAT_F32)
+		arm_fill_f32(0.f, d->buffer, d->capacity);
+	else
+		memset(d->samples, 0, d->capacity * sizeof(uint16_t));
+
+	return;
+}
+
+
+//	Move the read tap to a delay of M samples, up to the length the delay line was created with.  The line always holds
+//	the last capacity samples, so nothing is cleared and the tap lands on the samples that were written M samples ago.
+//	The output jumps from the old tap to the new one, so a line that is being listened to should be faded from one to
+//	the other (see delayLineReadTap())
+int delayLineSetLength(DelayLine *d, size_t M)
+{
+	if (d == NULL) return -1;
+	if ((M == 0) || (M > d->capacity)) return -1;
+
+	d->M = M;
+
+	return 0;
+}
+
+
+//	Storage index of the read tap, M samples behind the write pointer
+static inline size_t delayLineTapIndex(const DelayLine *d)
+{
+	size_t index = d->currentPtr + (d->capacity - d->M);
+
+	return (index >= d->capacity) ? (index - d->capacity) : index;
+}
+
+
+//	Read the n samples a tap at the given delay would output for the next n samples shifted in: dst[i] is the sample
+//	written delay samples before the (i + 1)th next one.  n must not be more than delay, and delay must not be more
+//	than the capacity.  Used to fade out an old tap after delayLineSetLength() has moved it
+int delayLineReadTap(DelayLine *d, size_t delay, float32_t *dst, size_t n)
+{
+	if ((d == NULL) || (dst == NULL)) return -1;
+	if ((delay == 0) || (delay > d->capacity) || (n > delay) || (d->currentPtr >= d->capacity)) return -1;
+
+	size_t index = d->currentPtr + (d->capacity - delay);
+	if (index >= d->capacity)
+		index -= d->capacity;
+
+	while (n > 0)
+	{
+		size_t count = d->capacity - index;
+		if (count > n)
+			count = n;
+
+		if (d->format == DELAY_LINE_FORMAT_F32)
+			memcpy(dst, d->buffer + index, sizeof(float32_t) * count);
+		else
+			delayLineLoad(d, index, dst, count);
+
+		index = 0;
+		dst += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
 int delayLineShift(DelayLine *d, float32_t x, float32_t *y)
 {
 	if (d == NULL) return -1;
 	if (d->M != 0)
 	{
 		//	0 <= currentPtr < N assertion
-		if (d->currentPtr >= d->M)
+		if (d->currentPtr >= d->capacity)
 			return -1;
 
-		*y = d->buffer[d->currentPtr];
-		d->buffer[d->currentPtr] = x;
+		float32_t *line = delayLineAcquire(d, 1);
 
-		d->currentPtr += 1;
-		if (d->currentPtr >= d->M)
-			d->currentPtr = 0;
+		*y = line[0];
+		line[0] = x;
+
+		delayLineRelease(d, 1);
 	}
 
 	//	Pass-through case (N = 0)
@@ -81,11 +426,539 @@ int delayLineShift(DelayLine *d, float32_t x, float32_t *y)
 int delayLinePeek(DelayLine *d, float32_t *y)
 {
 	if (d == NULL) return -1;
-	if (d->currentPtr >= d->M) return -1;
+	if (d->currentPtr >= d->capacity) return -1;
 
-	*y = d->buffer[d->currentPtr];
+	size_t index = delayLineTapIndex(d);
+
+	if (d->format == DELAY_LINE_FORMAT_F32)
+		*y = d->buffer[index];
+	else
+		delayLineLoad(d, index, y, 1);
+
+	return 0;
+}
+
+
+//	Shift a block of n samples through the delay line.  The block is split at most twice around the wrap point
+//	(more often only if n > M) so that each piece is moved with bulk copies instead of one delayLineShift() per sample.
+//	x and y may point to the same buffer
+int delayLineProcessBlock(DelayLine *d, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((d == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	//	Pass-through case (M = 0)
+	if (d->M == 0)
+	{
+		if (x != y)
+			arm_copy_f32((float32_t *)x, y, n);
+
+		return 0;
+	}
+
+	if (d->currentPtr >= d->capacity) return -1;
+
+	while (n > 0)
+	{
+		size_t count = delayLineSpan(d, n);
+		float32_t *line = delayLineAcquire(d, count);
+
+		if (x != y)
+		{
+			arm_copy_f32(line, y, count);
+			arm_copy_f32((float32_t *)x, line, count);
+		}
+
+		//	In-place, the delayed samples and the input have to be swapped
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				float32_t delayOut = line[i];
+				line[i] = y[i];
+				y[i] = delayOut;
+			}
+		}
+
+		delayLineRelease(d, count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+//	Sample that was written delay samples before the most recent one (delay = 0 is the most recent sample)
+static float32_t delayLineGetSample(DelayLine *d, size_t delay)
+{
+	size_t index = (d->currentPtr > delay) ? (d->currentPtr - 1 - delay) : (d->currentPtr + d->capacity - 1 - delay);
+
+	if (d->format == DELAY_LINE_FORMAT_F32)
+		return d->buffer[index];
+
+	if (d->format == DELAY_LINE_FORMAT_Q15)
+		return (float32_t)((q15_t *)d->samples)[index] * (d->fullScale / 32768.f);
+
+	return halfToFloat(((uint16_t *)d->samples)[index]);
+}
+
+
+//	Interpolate the delay line at a fractional delay, counted in samples back from the most recently shifted in sample.
+//	The delay is clamped to the range the interpolator can reach: [0, M - 1] for linear, [1, M - 1] for allpass and
+//	[1, M - 3] for Hermite.  apState holds the allpass interpolator's previous output and is only used (and updated) by
+//	DELAY_LINE_INTERP_ALLPASS.  It should start at 0 and belong to one reader
+int delayLineReadFractional(DelayLine *d, float32_t delay, DelayLineInterp interp, float32_t *apState, float32_t *y)
+{
+	if ((d == NULL) || (y == NULL)) return -1;
+	if (d->currentPtr >= d->capacity) return -1;
+
+	float32_t minDelay = (interp == DELAY_LINE_INTERP_LINEAR) ? 0.f : 1.f;
+	float32_t maxDelay = (float32_t)d->M - ((interp == DELAY_LINE_INTERP_HERMITE) ? 3.f : 1.f);
+
+	if (maxDelay < minDelay) return -1;
+
+	if (delay < minDelay)
+		delay = minDelay;
+	if (delay > maxDelay)
+		delay = maxDelay;
+
+	size_t k = (size_t)delay;
+	float32_t frac = delay - (float32_t)k;
+
+	switch (interp)
+	{
+		case DELAY_LINE_INTERP_LINEAR:
+		{
+			float32_t x0 = delayLineGetSample(d, k);
+			float32_t x1 = (frac > 0.f) ? delayLineGetSample(d, k + 1) : x0;
+
+			*y = x0 + (frac * (x1 - x0));
+			break;
+		}
+
+		case DELAY_LINE_INTERP_ALLPASS:
+		{
+			if (apState == NULL) return -1;
+
+			//	Keep the fractional part in [0.618, 1.618) so that the allpass coefficient stays small
+			if ((frac < 0.618f) && (k > 0))
+			{
+				k -= 1;
+				frac += 1.f;
+			}
+
+			float32_t eta = (1.f - frac) / (1.f + frac);
+			float32_t x0 = delayLineGetSample(d, k);
+			float32_t x1 = (k + 1 < d->M) ? delayLineGetSample(d, k + 1) : x0;
+
+			*y = (eta * (x0 - *apState)) + x1;
+			*apState = *y;
+			break;
+		}
+
+		case DELAY_LINE_INTERP_HERMITE:
+		{
+			float32_t xm1 = delayLineGetSample(d, k - 1);
+			float32_t x0 = delayLineGetSample(d, k);
+			float32_t x1 = delayLineGetSample(d, k + 1);
+			float32_t x2 = delayLineGetSample(d, k + 2);
+
+			float32_t c1 = 0.5f * (x1 - xm1);
+			float32_t c2 = xm1 - (2.5f * x0) + (2.f * x1) - (0.5f * x2);
+			float32_t c3 = (0.5f * (x2 - xm1)) + (1.5f * (x0 - x1));
+
+			*y = (((c3 * frac) + c2) * frac + c1) * frac + x0;
+			break;
+		}
+
+		default:
+			return -1;
+	}
+
+	return 0;
+}
+
+
+//	Write count samples of x at ptr, in at most two runs split at the wrap point.  The samples they replace are the
+//	oldest in the line, and are kept in overwritten (oldest first) for the reads that still need them
+static void delayLineWriteChunk(float32_t *buffer, size_t M, size_t ptr, const float32_t *x, size_t count, float32_t *overwritten)
+{
+	size_t first = M - ptr;
+	if (first > count)
+		first = count;
+
+	memcpy(overwritten, buffer + ptr, sizeof(float32_t) * first);
+	memcpy(buffer + ptr, x, sizeof(float32_t) * first);
+
+	if (count > first)
+	{
+		memcpy(overwritten + first, buffer, sizeof(float32_t) * (count - first));
+		memcpy(buffer, x + first, sizeof(float32_t) * (count - first));
+	}
+}
+
+
+//	The sample at time t, where time 0 is the first sample of the chunk delayLineWriteChunk() wrote at ptr.  Times from
+//	-M up to count - 1 can be read.  A time before limit = count - M was overwritten by the chunk and is read from
+//	overwritten, any other one from the line
+static inline float32_t delayLineTap(const float32_t *buffer, const float32_t *overwritten, int32_t ptr, int32_t M,
+									 int32_t limit, int32_t t)
+{
+	if (t < limit)
+		return overwritten[t + M];
+
+	int32_t index = ptr + t;
+
+	if (index < 0)
+		index += M;
+	else if (index >= M)
+		index -= M;
+
+	return buffer[index];
+}
+
+
+#if defined(__AVX2__)
+//	delayLineTap() at eight times, gathered
+static inline __m256 delayLineTap8(const float32_t *buffer, const float32_t *overwritten, __m256i ptr, __m256i M,
+								   __m256i limit, __m256i t)
+{
+	//	ptr + t is in [-M, 2M), one correction either way brings it into the line
+	__m256i index = _mm256_add_epi32(t, ptr);
+	index = _mm256_add_epi32(index, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), index), M));
+	index = _mm256_sub_epi32(index, _mm256_andnot_si256(_mm256_cmpgt_epi32(M, index), M));
+
+	__m256 v = _mm256_i32gather_ps(buffer, index, 4);
+	__m256i old = _mm256_cmpgt_epi32(limit, t);
+
+	if (!_mm256_testz_si256(old, old))
+		v = _mm256_mask_i32gather_ps(v, overwritten, _mm256_add_epi32(t, M), _mm256_castsi256_ps(old), 4);
+
+	return v;
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+//	delayLineTap() at four times.  There is no gather before AVX2, so only the index math is done four-wide
+static inline __m128 delayLineTap4(const float32_t *buffer, const float32_t *overwritten, __m128i ptr, __m128i M,
+								   __m128i limit, __m128i t)
+{
+	__m128i index = _mm_add_epi32(t, ptr);
+	index = _mm_add_epi32(index, _mm_and_si128(_mm_cmpgt_epi32(_mm_setzero_si128(), index), M));
+	index = _mm_sub_epi32(index, _mm_andnot_si128(_mm_cmpgt_epi32(M, index), M));
+
+	int32_t lineIndex[4];
+	int32_t oldIndex[4];
+	int32_t old[4];
+	float32_t v[4];
+
+	_mm_storeu_si128((__m128i *)lineIndex, index);
+	_mm_storeu_si128((__m128i *)oldIndex, _mm_add_epi32(t, M));
+	_mm_storeu_si128((__m128i *)old, _mm_cmpgt_epi32(limit, t));
+
+	for (int lane = 0; lane < 4; ++lane)
+		v[lane] = old[lane] ? overwritten[oldIndex[lane]] : buffer[lineIndex[lane]];
+
+	return _mm_loadu_ps(v);
+}
+#endif
+
+
+//	Shift each x[i] into the delay line, then read it back at the fractional delay delay[i] (see delayLineReadFractional()).
+//	Used for modulated effects such as chorus, flanger and vibrato.
+//	Float delay lines are processed DELAY_LINE_FRACTIONAL_CHUNK samples at a time in two passes.  The chunk is first
+//	written into the line, then every output is read back: the delay is split into its integer and fractional parts,
+//	the interpolator's taps are gathered and combined, eight outputs at a time with AVX2 and four with SSE2.  Only the
+//	allpass recursion is left for a scalar loop at the end.  x and y may point to the same buffer
+int delayLineProcessFractionalBlock(DelayLine *d, const float32_t *x, const float32_t *delay, float32_t *y, size_t n,
+									DelayLineInterp interp, float32_t *apState)
+{
+	if ((d == NULL) || (x == NULL) || (delay == NULL) || (y == NULL)) return -1;
+	if ((interp == DELAY_LINE_INTERP_ALLPASS) && (apState == NULL)) return -1;
+	if ((interp != DELAY_LINE_INTERP_LINEAR) && (interp != DELAY_LINE_INTERP_ALLPASS) && (interp != DELAY_LINE_INTERP_HERMITE)) return -1;
+
+	//	Compact formats and very short (or very long) delay lines go through the per-sample functions
+	if ((d->format != DELAY_LINE_FORMAT_F32) || (d->M < 4) || (d->capacity > (size_t)INT32_MAX / 2))
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			float32_t delayOut = 0.f;
+
+			if (delayLineShift(d, x[i], &delayOut) < 0)
+				return -1;
+
+			if (delayLineReadFractional(d, delay[i], interp, apState, &y[i]) < 0)
+				return -1;
+		}
+
+		return 0;
+	}
+
+	if (d->currentPtr >= d->capacity) return -1;
+
+	//	M is the length of the storage here, the delays are limited by the line's own M
+	float32_t *buffer = d->buffer;
+	int32_t M = (int32_t)d->capacity;
+	int32_t ptr = (int32_t)d->currentPtr;
+
+	float32_t minDelay = (interp == DELAY_LINE_INTERP_LINEAR) ? 0.f : 1.f;
+	float32_t maxDelay = (float32_t)d->M - ((interp == DELAY_LINE_INTERP_HERMITE) ? 3.f : 1.f);
+	float32_t state = (apState != NULL) ? *apState : 0.f;
+
+	//	The allpass keeps its taps and coefficients for the recursion
+	float32_t overwritten[DELAY_LINE_FRACTIONAL_CHUNK];
+	float32_t t0[DELAY_LINE_FRACTIONAL_CHUNK];
+	float32_t t1[DELAY_LINE_FRACTIONAL_CHUNK];
+	float32_t eta[DELAY_LINE_FRACTIONAL_CHUNK];
+
+	while (n > 0)
+	{
+		int32_t count = (n < DELAY_LINE_FRACTIONAL_CHUNK) ? (int32_t)n : DELAY_LINE_FRACTIONAL_CHUNK;
+		if (count > M)
+			count = M;
+
+		delayLineWriteChunk(buffer, (size_t)M, (size_t)ptr, x, (size_t)count, overwritten);
+
+		int32_t limit = count - M;
+		int32_t i = 0;
+
+		//	Sample i's delay of k + frac samples puts its nearest tap at time i - k.  The allpass keeps its fractional
+		//	part in [0.618, 1.618) so that its coefficient stays small
+#if defined(__AVX2__)
+		const __m256i vPtr = _mm256_set1_epi32(ptr);
+		const __m256i vM = _mm256_set1_epi32(M);
+		const __m256i vLimit = _mm256_set1_epi32(limit);
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		const __m256 vMin = _mm256_set1_ps(minDelay);
+		const __m256 vMax = _mm256_set1_ps(maxDelay);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 D = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(delay + i), vMin), vMax);
+			__m256i k = _mm256_cvttps_epi32(D);
+			__m256 frac = _mm256_sub_ps(D, _mm256_cvtepi32_ps(k));
+			__m256i time = _mm256_add_epi32(_mm256_set1_epi32(i), lane);
+			__m256i r = _mm256_sub_epi32(time, k);
+
+			if (interp == DELAY_LINE_INTERP_LINEAR)
+			{
+				__m256 x0 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, r);
+				__m256 x1 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, _mm256_sub_epi32(r, one));
+
+				_mm256_storeu_ps(y + i, _mm256_add_ps(x0, _mm256_mul_ps(frac, _mm256_sub_ps(x1, x0))));
+			}
+			else if (interp == DELAY_LINE_INTERP_ALLPASS)
+			{
+				__m256i shift = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(frac, _mm256_set1_ps(0.618f), _CMP_LT_OQ)),
+												 _mm256_cmpgt_epi32(time, r));
+
+				r = _mm256_sub_epi32(r, shift);
+				frac = _mm256_add_ps(frac, _mm256_and_ps(_mm256_castsi256_ps(shift), _mm256_set1_ps(1.f)));
+
+				_mm256_storeu_ps(eta + i, _mm256_div_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), frac), _mm256_add_ps(_mm256_set1_ps(1.f), frac)));
+				_mm256_storeu_ps(t0 + i, delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, r));
+				_mm256_storeu_ps(t1 + i, delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, _mm256_sub_epi32(r, one)));
+			}
+			else
+			{
+				__m256 xm1 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, _mm256_add_epi32(r, one));
+				__m256 x0 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, r);
+				__m256 x1 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, _mm256_sub_epi32(r, one));
+				__m256 x2 = delayLineTap8(buffer, overwritten, vPtr, vM, vLimit, _mm256_sub_epi32(r, _mm256_set1_epi32(2)));
+
+				__m256 c1 = _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_sub_ps(x1, xm1));
+				__m256 c2 = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(xm1, _mm256_mul_ps(_mm256_set1_ps(2.5f), x0)),
+														_mm256_mul_ps(_mm256_set1_ps(2.f), x1)),
+										  _mm256_mul_ps(_mm256_set1_ps(0.5f), x2));
+				__m256 c3 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_sub_ps(x2, xm1)),
+										  _mm256_mul_ps(_mm256_set1_ps(1.5f), _mm256_sub_ps(x0, x1)));
+
+				__m256 v = _mm256_add_ps(_mm256_mul_ps(c3, frac), c2);
+				v = _mm256_add_ps(_mm256_mul_ps(v, frac), c1);
+				_mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_mul_ps(v, frac), x0));
+			}
+		}
+#elif defined(__SSE2__) || defined(_M_X64)
+		const __m128i vPtr = _mm_set1_epi32(ptr);
+		const __m128i vM = _mm_set1_epi32(M);
+		const __m128i vLimit = _mm_set1_epi32(limit);
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+		const __m128 vMin = _mm_set1_ps(minDelay);
+		const __m128 vMax = _mm_set1_ps(maxDelay);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 D = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(delay + i), vMin), vMax);
+			__m128i k = _mm_cvttps_epi32(D);
+			__m128 frac = _mm_sub_ps(D, _mm_cvtepi32_ps(k));
+			__m128i time = _mm_add_epi32(_mm_set1_epi32(i), lane);
+			__m128i r = _mm_sub_epi32(time, k);
+
+			if (interp == DELAY_LINE_INTERP_LINEAR)
+			{
+				__m128 x0 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, r);
+				__m128 x1 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, _mm_sub_epi32(r, one));
+
+				_mm_storeu_ps(y + i, _mm_add_ps(x0, _mm_mul_ps(frac, _mm_sub_ps(x1, x0))));
+			}
+			else if (interp == DELAY_LINE_INTERP_ALLPASS)
+			{
+				__m128i shift = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(frac, _mm_set1_ps(0.618f))), _mm_cmpgt_epi32(time, r));
+
+				r = _mm_sub_epi32(r, shift);
+				frac = _mm_add_ps(frac, _mm_and_ps(_mm_castsi128_ps(shift), _mm_set1_ps(1.f)));
+
+				_mm_storeu_ps(eta + i, _mm_div_ps(_mm_sub_ps(_mm_set1_ps(1.f), frac), _mm_add_ps(_mm_set1_ps(1.f), frac)));
+				_mm_storeu_ps(t0 + i, delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, r));
+				_mm_storeu_ps(t1 + i, delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, _mm_sub_epi32(r, one)));
+			}
+			else
+			{
+				__m128 xm1 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, _mm_add_epi32(r, one));
+				__m128 x0 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, r);
+				__m128 x1 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, _mm_sub_epi32(r, one));
+				__m128 x2 = delayLineTap4(buffer, overwritten, vPtr, vM, vLimit, _mm_sub_epi32(r, _mm_set1_epi32(2)));
+
+				__m128 c1 = _mm_mul_ps(_mm_set1_ps(0.5f), _mm_sub_ps(x1, xm1));
+				__m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(xm1, _mm_mul_ps(_mm_set1_ps(2.5f), x0)), _mm_mul_ps(_mm_set1_ps(2.f), x1)),
+									   _mm_mul_ps(_mm_set1_ps(0.5f), x2));
+				__m128 c3 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.5f), _mm_sub_ps(x2, xm1)), _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x0, x1)));
+
+				__m128 v = _mm_add_ps(_mm_mul_ps(c3, frac), c2);
+				v = _mm_add_ps(_mm_mul_ps(v, frac), c1);
+				_mm_storeu_ps(y + i, _mm_add_ps(_mm_mul_ps(v, frac), x0));
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			float32_t D = (delay[i] < minDelay) ? minDelay : ((delay[i] > maxDelay) ? maxDelay : delay[i]);
+			int32_t k = (int32_t)D;
+			float32_t frac = D - (float32_t)k;
+			int32_t r = i - k;
+
+			if (interp == DELAY_LINE_INTERP_LINEAR)
+			{
+				float32_t x0 = delayLineTap(buffer, overwritten, ptr, M, limit, r);
+				float32_t x1 = delayLineTap(buffer, overwritten, ptr, M, limit, r - 1);
+
+				y[i] = x0 + (frac * (x1 - x0));
+			}
+			else if (interp == DELAY_LINE_INTERP_ALLPASS)
+			{
+				if ((frac < 0.618f) && (k > 0))
+				{
+					r += 1;
+					frac += 1.f;
+				}
+
+				eta[i] = (1.f - frac) / (1.f + frac);
+				t0[i] = delayLineTap(buffer, overwritten, ptr, M, limit, r);
+				t1[i] = delayLineTap(buffer, overwritten, ptr, M, limit, r - 1);
+			}
+			else
+			{
+				float32_t xm1 = delayLineTap(buffer, overwritten, ptr, M, limit, r + 1);
+				float32_t x0 = delayLineTap(buffer, overwritten, ptr, M, limit, r);
+				float32_t x1 = delayLineTap(buffer, overwritten, ptr, M, limit, r - 1);
+				float32_t x2 = delayLineTap(buffer, overwritten, ptr, M, limit, r - 2);
+
+				float32_t c1 = 0.5f * (x1 - xm1);
+				float32_t c2 = xm1 - (2.5f * x0) + (2.f * x1) - (0.5f * x2);
+				float32_t c3 = (0.5f * (x2 - xm1)) + (1.5f * (x0 - x1));
+
+				y[i] = (((c3 * frac) + c2) * frac + c1) * frac + x0;
+			}
+		}
+
+		if (interp == DELAY_LINE_INTERP_ALLPASS)
+		{
+			for (i = 0; i < count; ++i)
+			{
+				state = (eta[i] * (t0[i] - state)) + t1[i];
+				y[i] = state;
+			}
+		}
+
+		ptr += count;
+		if (ptr >= M)
+			ptr -= M;
+
+		x += count;
+		delay += count;
+		y += count;
+		n -= (size_t)count;
+	}
+
+	if (apState != NULL)
+		*apState = state;
+
+	d->currentPtr = (size_t)ptr;
 
 	return 0;
 }
 
 
+//	Block kernels access the delay line in pieces:
+//		count = delayLineSpan(d, n);			number of samples (at most n) that can be accessed in one piece
+//		line = delayLineAcquire(d, count);		float view of the next count samples, line[i] being the tap's output
+//		...read line[i] and replace it with the new sample...
+//		delayLineRelease(d, count);				store the piece and advance the pointer past it
+//	A piece never crosses the wrap point of the write pointer or of the read tap, is never longer than the delay, and
+//	for compact formats it is limited to DELAY_LINE_SCRATCH_SIZE samples
+size_t delayLineSpan(DelayLine *d, size_t n)
+{
+	if ((d == NULL) || (d->currentPtr >= d->capacity)) return 0;
+
+	size_t count = d->capacity - d->currentPtr;
+
+	//	The tap has been moved in from the end of the storage
+	if (d->M < d->capacity)
+	{
+		size_t tapCount = d->capacity - delayLineTapIndex(d);
+
+		count = (tapCount < count) ? tapCount : count;
+		count = (d->M < count) ? d->M : count;
+	}
+
+	if ((d->format != DELAY_LINE_FORMAT_F32) && (count > DELAY_LINE_SCRATCH_SIZE))
+		count = DELAY_LINE_SCRATCH_SIZE;
+
+	return (count < n) ? count : n;
+}
+
+
+//	When the tap has been moved in from the end of the storage, the tap's samples are copied to where the new ones
+//	will be written, which holds samples older than any tap can reach
+float32_t *delayLineAcquire(DelayLine *d, size_t n)
+{
+	size_t index = delayLineTapIndex(d);
+
+	if (d->format == DELAY_LINE_FORMAT_F32)
+	{
+		if (index != d->currentPtr)
+			memmove(&d->buffer[d->currentPtr], &d->buffer[index], sizeof(float32_t) * n);
+
+		return &d->buffer[d->currentPtr];
+	}
+
+	delayLineLoad(d, index, d->buffer, n);
+
+	return d->buffer;
+}
+
+
+void delayLineRelease(DelayLine *d, size_t n)
+{
+	if (d->format != DELAY_LINE_FORMAT_F32)
+		delayLineStore(d, d->currentPtr, d->buffer, n);
+
+	d->currentPtr += n;
+	if (d->currentPtr >= d->capacity)
+		d->currentPtr = 0;
+}
+
+
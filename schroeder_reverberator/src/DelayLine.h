@@ -10,19 +10,88 @@
 
 #include "arm_math.h"
 #include "stdlib.h"
+#include "Arena.h"
+
+#if defined(__AVX2__) || defined(__F16C__)
+#include "immintrin.h"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include "emmintrin.h"
+#endif
+
+
+//	Number of samples a compact delay line converts to float at a time
+#define DELAY_LINE_SCRATCH_SIZE 64
+
+//	Number of samples delayLineProcessFractionalBlock() writes and then reads back at a time.  Its working arrays are on
+//	the stack, four of this many floats
+#define DELAY_LINE_FRACTIONAL_CHUNK 64
+
+
+//	Format the delay line stores its samples in.  Filter math is always done in float, compact formats are converted
+//	on the way in and out of the delay line, DELAY_LINE_SCRATCH_SIZE samples at a time.
+//	The compact formats halve the RAM but are not free: in bench_storage_format (main.c's reverberator on the host) float
+//	storage runs at about 6 ns/sample, F16 at about 8-10 with F16C and Q15 at about 25, 4x float, plus the time the
+//	scratch copies take on the target.  Neither is a lossless stand-in for float either.  Against float storage the
+//	reverberator's output SNR is 76 dB for Q15 at a fullScale of 32768 and 73 dB for F16, the latter just under the 74 dB
+//	of the 12-bit DAC: F16 keeps 11 significant bits relative to each sample, and main.c's combs carry the input's
+//	amplified mid-scale level, so most of those bits go to the level rather than to the signal around it
+typedef enum
+{
+	DELAY_LINE_FORMAT_F32 = 0,
+	DELAY_LINE_FORMAT_Q15,		//	Signed 16-bit fixed point, +/- fullScale maps to +/- 1
+	DELAY_LINE_FORMAT_F16		//	IEEE 754 half precision float
+}DelayLineFormat;
+
+
+//	Interpolation used to read between samples
+typedef enum
+{
+	DELAY_LINE_INTERP_LINEAR = 0,
+	DELAY_LINE_INTERP_ALLPASS,	//	First-order allpass, needs one float of state per reader
+	DELAY_LINE_INTERP_HERMITE	//	4-point, 3rd-order Hermite
+}DelayLineInterp;
+
 
 typedef struct
 {
-	float32_t *buffer;
-	size_t currentPtr;
-	size_t M;
+	float32_t *buffer;			//	Sample storage for DELAY_LINE_FORMAT_F32, conversion scratch for compact formats
+	size_t currentPtr;			//	Write pointer
+	size_t M;					//	Delay, the read tap is M samples behind the write pointer
+	size_t capacity;			//	Length of the storage, which holds the last capacity samples.  M can be moved up to this
+	DelayLineFormat format;
+	void *samples;				//	Sample storage for compact formats
+	float32_t fullScale;
 }DelayLine;
 
 
+//	Number of arena bytes used by createDelayLineInArena()
+#define DELAY_LINE_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(DelayLine)) + ARENA_ALIGN((M) * sizeof(float32_t)))
+
+//	Number of arena bytes used by createDelayLineWithFormatInArena() for a compact format
+#define DELAY_LINE_COMPACT_ARENA_SIZE(M) (ARENA_ALIGN(sizeof(DelayLine)) + ARENA_ALIGN((M) * sizeof(uint16_t)) + \
+										ARENA_ALIGN(DELAY_LINE_SCRATCH_SIZE * sizeof(float32_t)))
+
+
 DelayLine		*createDelayLine(size_t M);
+DelayLine		*createDelayLineWithFormat(size_t M, DelayLineFormat format, float32_t fullScale);
+DelayLine		*createDelayLineInArena(Arena *a, size_t M);
+DelayLine		*createDelayLineWithFormatInArena(Arena *a, size_t M, DelayLineFormat format, float32_t fullScale);
+size_t			delayLineArenaSize(size_t M, DelayLineFormat format);
+int				delayLineInit(DelayLine *d, size_t M, DelayLineFormat format, float32_t fullScale, float32_t *buffer, void *samples);
 void 			deleteDelayLine(DelayLine *d);
+void			delayLineReset(DelayLine *d);
+int				delayLineSetLength(DelayLine *d, size_t M);
+int				delayLineReadTap(DelayLine *d, size_t delay, float32_t *dst, size_t n);
 int 			delayLineShift(DelayLine *d, float32_t x, float32_t *y);
 int 			delayLinePeek(DelayLine *d, float32_t *y);
+int 			delayLineProcessBlock(DelayLine *d, const float32_t *x, float32_t *y, size_t n);
+int				delayLineReadFractional(DelayLine *d, float32_t delay, DelayLineInterp interp, float32_t *apState, float32_t *y);
+int				delayLineProcessFractionalBlock(DelayLine *d, const float32_t *x, const float32_t *delay, float32_t *y, size_t n,
+												DelayLineInterp interp, float32_t *apState);
+
+size_t			delayLineSpan(DelayLine *d, size_t n);
+float32_t		*delayLineAcquire(DelayLine *d, size_t n);
+void			delayLineRelease(DelayLine *d, size_t n);
 
 
 #endif /* SRC_DELAYLINE_H_ */
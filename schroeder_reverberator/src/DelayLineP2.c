@@ -0,0 +1,154 @@
+/*
+ * DelayLineP2.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "DelayLineP2.h"
+
+
+//	Smallest power of two >= M
+size_t delayLineP2Capacity(size_t M)
+{
+	size_t capacity = 1;
+	while (capacity < M)
+		capacity <<= 1;
+
+	return capacity;
+}
+
+
+DelayLineP2 *createDelayLineP2(size_t M)
+{
+	DelayLineP2 *d = (DelayLineP2 *)malloc(sizeof(DelayLineP2));
+	if (d == NULL)
+		return NULL;
+
+	size_t capacity = delayLineP2Capacity(M);
+
+	d->buffer = (float32_t *)malloc(sizeof(float32_t) * capacity);
+	if (d->buffer == NULL)
+	{
+		free(d);
+		return NULL;
+	}
+
+	arm_fill_f32(0.f, d->buffer, capacity);
+
+	d->M = M;
+	d->mask = capacity - 1;
+	d->writePtr = 0;
+
+	return d;
+}
+
+
+DelayLineP2 *createDelayLineP2InArena(Arena *a, size_t M)
+{
+	DelayLineP2 *d = (DelayLineP2 *)arenaAlloc(a, sizeof(DelayLineP2));
+	if (d == NULL)
+		return NULL;
+
+	size_t capacity = delayLineP2Capacity(M);
+
+	d->buffer = (float32_t *)arenaAlloc(a, sizeof(float32_t) * capacity);
+	if (d->buffer == NULL)
+		return NULL;
+
+	arm_fill_f32(0.f, d->buffer, capacity);
+
+	d->M = M;
+	d->mask = capacity - 1;
+	d->writePtr = 0;
+
+	return d;
+}
+
+
+size_t delayLineP2ArenaSize(size_t M)
+{
+	return ARENA_ALIGN(sizeof(DelayLineP2)) + ARENA_ALIGN(sizeof(float32_t) * delayLineP2Capacity(M));
+}
+
+
+void deleteDelayLineP2(DelayLineP2 *d)
+{
+	if (d == NULL)
+		return;
+
+	if (d->buffer != NULL)
+	{
+		free(d->buffer);
+		d->buffer = NULL;
+	}
+
+	free(d);
+	d = NULL;
+
+	return;
+}
+
+
+//	M = 0 passes x straight through, as with delayLineShift()
+int delayLineP2Shift(DelayLineP2 *d, float32_t x, float32_t *y)
+{
+	if (d == NULL) return -1;
+
+	if (d->M == 0)
+	{
+		*y = x;
+		return 0;
+	}
+
+	*y = d->buffer[(d->writePtr - d->M) & d->mask];
+	d->buffer[d->writePtr] = x;
+	d->writePtr = (d->writePtr + 1) & d->mask;
+
+	return 0;
+}
+
+
+int delayLineP2Peek(DelayLineP2 *d, float32_t *y)
+{
+	if ((d == NULL) || (d->M == 0)) return -1;
+
+	*y = d->buffer[(d->writePtr - d->M) & d->mask];
+
+	return 0;
+}
+
+
+//	x and y may point to the same buffer
+int delayLineP2ProcessBlock(DelayLineP2 *d, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((d == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	if (d->M == 0)
+	{
+		if (x != y)
+			arm_copy_f32((float32_t *)x, y, n);
+
+		return 0;
+	}
+
+	float32_t *buffer = d->buffer;
+	size_t mask = d->mask;
+	size_t readPtr = d->writePtr - d->M;
+	size_t writePtr = d->writePtr;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float32_t delayOut = buffer[readPtr & mask];
+		buffer[writePtr] = x[i];
+		y[i] = delayOut;
+
+		readPtr += 1;
+		writePtr = (writePtr + 1) & mask;
+	}
+
+	d->writePtr = writePtr;
+
+	return 0;
+}
+
+
@@ -0,0 +1,96 @@
+/*
+ * DelayLineP2.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_DELAYLINEP2_H_
+#define SRC_DELAYLINEP2_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+
+
+//	Delay line whose buffer length is rounded up to a power of two so that the pointers wrap with a bitmask instead of a
+//	compare-and-reset.  The delay is still exactly M samples: the write pointer moves through the whole buffer and the
+//	read pointer trails it by M
+typedef struct
+{
+	float32_t *buffer;
+	size_t writePtr;
+	size_t mask;
+	size_t M;
+}DelayLineP2;
+
+
+DelayLineP2		*createDelayLineP2(size_t M);
+DelayLineP2		*createDelayLineP2InArena(Arena *a, size_t M);
+size_t			delayLineP2Capacity(size_t M);
+size_t			delayLineP2ArenaSize(size_t M);
+void			deleteDelayLineP2(DelayLineP2 *d);
+int				delayLineP2Shift(DelayLineP2 *d, float32_t x, float32_t *y);
+int				delayLineP2Peek(DelayLineP2 *d, float32_t *y);
+int				delayLineP2ProcessBlock(DelayLineP2 *d, const float32_t *x, float32_t *y, size_t n);
+
+
+
+//	Compile-time sized version.  DECLARE_STATIC_DELAY_LINE(Name, M) defines a struct type Name holding the whole
+//	buffer and the functions
+//		void		NameInit(Name *d);
+//		float32_t	NamePeek(Name *d);
+//		float32_t	NameShift(Name *d, float32_t x);
+//		void		NameProcessBlock(Name *d, const float32_t *x, float32_t *y, size_t n);
+//	The delay, buffer length and mask are constants, so the compiler can fold all of the index arithmetic.
+//	M must be a constant expression between 1 and 2^31
+
+#define DELAY_LINE_P2_SMEAR1(x) ((x) | ((x) >> 1))
+#define DELAY_LINE_P2_SMEAR2(x) (DELAY_LINE_P2_SMEAR1(x) | (DELAY_LINE_P2_SMEAR1(x) >> 2))
+#define DELAY_LINE_P2_SMEAR4(x) (DELAY_LINE_P2_SMEAR2(x) | (DELAY_LINE_P2_SMEAR2(x) >> 4))
+#define DELAY_LINE_P2_SMEAR8(x) (DELAY_LINE_P2_SMEAR4(x) | (DELAY_LINE_P2_SMEAR4(x) >> 8))
+#define DELAY_LINE_P2_SMEAR16(x) (DELAY_LINE_P2_SMEAR8(x) | (DELAY_LINE_P2_SMEAR8(x) >> 16))
+
+//	Smallest power of two >= M
+#define DELAY_LINE_P2_CAPACITY(M) (DELAY_LINE_P2_SMEAR16((uint32_t)(M) - 1u) + 1u)
+
+#define DECLARE_STATIC_DELAY_LINE(Name, M)																\
+	typedef struct																						\
+	{																									\
+		float32_t buffer[DELAY_LINE_P2_CAPACITY(M)];													\
+		size_t writePtr;																				\
+	}Name;																								\
+																										\
+	static inline void Name##Init(Name *d)																\
+	{																									\
+		arm_fill_f32(0.f, d->buffer, DELAY_LINE_P2_CAPACITY(M));										\
+		d->writePtr = 0;																				\
+	}																									\
+																										\
+	static inline float32_t Name##Peek(Name *d)															\
+	{																									\
+		return d->buffer[(d->writePtr - (M)) & (DELAY_LINE_P2_CAPACITY(M) - 1)];						\
+	}																									\
+																										\
+	static inline float32_t Name##Shift(Name *d, float32_t x)											\
+	{																									\
+		float32_t y = d->buffer[(d->writePtr - (M)) & (DELAY_LINE_P2_CAPACITY(M) - 1)];					\
+		d->buffer[d->writePtr] = x;																		\
+		d->writePtr = (d->writePtr + 1) & (DELAY_LINE_P2_CAPACITY(M) - 1);								\
+		return y;																						\
+	}																									\
+																										\
+	static inline void Name##ProcessBlock(Name *d, const float32_t *x, float32_t *y, size_t n)			\
+	{																									\
+		size_t w = d->writePtr;																			\
+		for (size_t i = 0; i < n; ++i)																	\
+		{																								\
+			float32_t delayOut = d->buffer[(w - (M)) & (DELAY_LINE_P2_CAPACITY(M) - 1)];				\
+			d->buffer[w] = x[i];																		\
+			y[i] = delayOut;																			\
+			w = (w + 1) & (DELAY_LINE_P2_CAPACITY(M) - 1);												\
+		}																								\
+		d->writePtr = w;																				\
+	}
+
+
+#endif /* SRC_DELAYLINEP2_H_ */
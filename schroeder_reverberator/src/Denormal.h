@@ -0,0 +1,96 @@
+/*
+ * Denormal.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_DENORMAL_H_
+#define SRC_DENORMAL_H_
+
+#include "arm_math.h"
+#include "stdint.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include "xmmintrin.h"
+#endif
+
+
+//	The tails of the feedback filters decay towards 0 forever and eventually reach subnormal floats, which are an
+//	order of magnitude slower than normal floats on most desktop CPUs.  Two ways around it are provided:
+//
+//	DENORMAL_PROTECTION_FTZ (on by default): the block processing functions of the reverberators switch the FPU to
+//	flush-to-zero (and denormals-are-zero on x86) for the duration of the call with denormalGuardBegin() /
+//	denormalGuardEnd().  FPSCR.FZ on Cortex-M4F, MXCSR.FTZ / DAZ with SSE, FPCR.FZ on AArch64
+//
+//	DENORMAL_PROTECTION_DC (off by default): add DENORMAL_DC to the input of every feedback loop, so that the loops
+//	settle at a tiny constant instead of decaying into the subnormal range.  For platforms where FTZ can't be set.
+//	DENORMAL_DC is far below 1 LSB of any converter
+#ifndef DENORMAL_PROTECTION_FTZ
+#define DENORMAL_PROTECTION_FTZ 1
+#endif
+
+#ifndef DENORMAL_PROTECTION_DC
+#define DENORMAL_PROTECTION_DC 0
+#endif
+
+#define DENORMAL_DC 1e-15f
+
+#if DENORMAL_PROTECTION_DC
+#define DENORMAL_PROTECT(x) ((x) + DENORMAL_DC)
+#else
+#define DENORMAL_PROTECT(x) (x)
+#endif
+
+#define DENORMAL_FPSCR_FZ (1UL << 24)
+#define DENORMAL_FPCR_FZ (1UL << 24)
+#define DENORMAL_MXCSR_FTZ (1U << 15)
+#define DENORMAL_MXCSR_DAZ (1U << 6)
+
+
+//	Floating point control register contents saved by denormalGuardBegin()
+typedef uint64_t DenormalState;
+
+
+//	Turn flush-to-zero on and return the previous FPU state, which must be passed to denormalGuardEnd() before
+//	returning to the caller
+static inline DenormalState denormalGuardBegin(void)
+{
+#if !DENORMAL_PROTECTION_FTZ
+	return 0;
+#elif defined(__SSE__) || defined(_M_X64)
+	uint32_t state = _mm_getcsr();
+	_mm_setcsr(state | DENORMAL_MXCSR_FTZ | DENORMAL_MXCSR_DAZ);
+	return state;
+#elif defined(__aarch64__)
+	uint64_t state;
+	__asm__ volatile ("mrs %0, fpcr" : "=r" (state));
+	__asm__ volatile ("msr fpcr, %0" : : "r" (state | DENORMAL_FPCR_FZ));
+	return state;
+#elif defined(__FPU_PRESENT) && (__FPU_PRESENT == 1)
+	uint32_t state = __get_FPSCR();
+	__set_FPSCR(state | DENORMAL_FPSCR_FZ);
+	return state;
+#else
+	return 0;
+#endif
+}
+
+
+//	Put the FPU back the way denormalGuardBegin() found it
+static inline void denormalGuardEnd(DenormalState state)
+{
+#if !DENORMAL_PROTECTION_FTZ
+	(void)state;
+#elif defined(__SSE__) || defined(_M_X64)
+	_mm_setcsr((uint32_t)state);
+#elif defined(__aarch64__)
+	__asm__ volatile ("msr fpcr, %0" : : "r" (state));
+#elif defined(__FPU_PRESENT) && (__FPU_PRESENT == 1)
+	__set_FPSCR((uint32_t)state);
+#else
+	(void)state;
+#endif
+}
+
+
+#endif /* SRC_DENORMAL_H_ */
@@ -0,0 +1,434 @@
+/*
+ * FBCFBank.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FBCFBank.h"
+
+
+//	Returns the sum of the delay lengths, or 0 if the bank can't be built with these parameters
+static size_t fbcfBankTotalLength(size_t N, const size_t *M)
+{
+	if (M == NULL)
+		return 0;
+
+	if ((N == 0) || (N > FBCF_BANK_MAX_COMBS))
+		return 0;
+
+	size_t totalLength = 0;
+	for (size_t j = 0; j < N; ++j)
+	{
+		if (M[j] == 0)
+			return 0;
+
+		totalLength += M[j];
+	}
+
+	return totalLength;
+}
+
+
+//	For DELAY_LINE_FORMAT_F32, buffer holds every delay line back to back.  For compact formats, samples holds every
+//	delay line back to back and buffer holds one conversion scratch area per delay line
+static int initFBCFBank(FBCFBank *b, float32_t *buffer, void *samples, size_t N, const size_t *M, const float32_t *b0, const float32_t *am,
+						DelayLineFormat format, float32_t fullScale)
+{
+	b->N = N;
+	b->buffer = buffer;
+	b->samples = samples;
+	b->fadeLength = 0;
+	b->fadePosition = 0;
+
+	float32_t *line = buffer;
+	uint16_t *compactLine = (uint16_t *)samples;
+
+	for (size_t j = 0; j < N; ++j)
+	{
+		b->b0[j] = b0[j];
+		b->am[j] = am[j];
+
+		if (delayLineInit(&b->lines[j], M[j], format, fullScale, line, compactLine) < 0)
+			return -1;
+
+		b->fadeM[j] = M[j];
+
+		if (format == DELAY_LINE_FORMAT_F32)
+			line += M[j];
+		else
+		{
+			line += DELAY_LINE_SCRATCH_SIZE;
+			compactLine += M[j];
+		}
+	}
+
+	return 0;
+}
+
+
+//	N can be up to FBCF_BANK_MAX_COMBS.  All N delay lines are allocated as one contiguous buffer
+FBCFBank *createFBCFBank(size_t N, const size_t *M, const float32_t *b0, const float32_t *am)
+{
+	return createFBCFBankWithFormat(N, M, b0, am, DELAY_LINE_FORMAT_F32, 1.f);
+}
+
+
+FBCFBank *createFBCFBankWithFormat(size_t N, const size_t *M, const float32_t *b0, const float32_t *am, DelayLineFormat format, float32_t fullScale)
+{
+	if ((b0 == NULL) || (am == NULL))
+		return NULL;
+
+	size_t totalLength = fbcfBankTotalLength(N, M);
+	if (totalLength == 0)
+		return NULL;
+
+	FBCFBank *b = (FBCFBank *)malloc(sizeof(FBCFBank));
+	if (b == NULL)
+		return NULL;
+
+	float32_t *buffer = NULL;
+	void *samples = NULL;
+
+	if (format == DELAY_LINE_FORMAT_F32)
+		buffer = (float32_t *)malloc(sizeof(float32_t) * totalLength);
+	else
+	{
+		buffer = (float32_t *)malloc(sizeof(float32_t) * N * DELAY_LINE_SCRATCH_SIZE);
+		samples = malloc(sizeof(uint16_t) * totalLength);
+	}
+
+	if ((buffer == NULL) || ((format != DELAY_LINE_FORMAT_F32) && (samples == NULL)) ||
+		(initFBCFBank(b, buffer, samples, N, M, b0, am, format, fullScale) < 0))
+	{
+		free(samples);
+		free(buffer);
+		free(b);
+		return NULL;
+	}
+
+	return b;
+}
+
+
+FBCFBank *createFBCFBankInArena(Arena *arena, size_t N, const size_t *M, const float32_t *b0, const float32_t *am)
+{
+	return createFBCFBankWithFormatInArena(arena, N, M, b0, am, DELAY_LINE_FORMAT_F32, 1.f);
+}
+
+
+FBCFBank *createFBCFBankWithFormatInArena(Arena *arena, size_t N, const size_t *M, const float32_t *b0, const float32_t *am,
+											DelayLineFormat format, float32_t fullScale)
+{
+	if ((b0 == NULL) || (am == NULL))
+		return NULL;
+
+	size_t totalLength = fbcfBankTotalLength(N, M);
+	if (totalLength == 0)
+		return NULL;
+
+	FBCFBank *b = (FBCFBank *)arenaAlloc(arena, sizeof(FBCFBank));
+	if (b == NULL)
+		return NULL;
+
+	float32_t *buffer = NULL;
+	void *samples = NULL;
+
+	if (format == DELAY_LINE_FORMAT_F32)
+		buffer = (float32_t *)arenaAlloc(arena, sizeof(float32_t) * totalLength);
+	else
+	{
+		samples = arenaAlloc(arena, sizeof(uint16_t) * totalLength);
+		buffer = (float32_t *)arenaAlloc(arena, sizeof(float32_t) * N * DELAY_LINE_SCRATCH_SIZE);
+	}
+
+	if (buffer == NULL)
+		return NULL;
+
+	if (initFBCFBank(b, buffer, samples, N, M, b0, am, format, fullScale) < 0)
+		return NULL;
+
+	return b;
+}
+
+
+size_t fbcfBankArenaSize(size_t N, const size_t *M, DelayLineFormat format)
+{
+	if (format == DELAY_LINE_FORMAT_F32)
+		return FBCF_BANK_ARENA_SIZE(fbcfBankTotalLength(N, M));
+
+	return FBCF_BANK_COMPACT_ARENA_SIZE(N, fbcfBankTotalLength(N, M));
+}
+
+
+//	Clear every comb in the bank back to silence
+void fbcfBankReset(FBCFBank *b)
+{
+	if (b == NULL) return;
+
+	for (size_t j = 0; j < b->N; ++j)
+		delayLineReset(&b->lines[j]);
+
+	b->fadePosition = b->fadeLength;
+
+	return;
+}
+
+
+//	Move every comb's delay to M[j] samples, up to the length its delay line was created with.  The lines keep their
+//	samples, so the tail carries on at the new delays.  Over the next fadeLength samples processed, each comb's output is
+//	faded from its old tap to its new one so that the move doesn't click.  A move made during a fade starts from the
+//	taps that were being faded in
+int fbcfBankSetLengths(FBCFBank *b, const size_t *M, size_t fadeLength)
+{
+	if ((b == NULL) || (M == NULL)) return -1;
+
+	for (size_t j = 0; j < b->N; ++j)
+	{
+		if ((M[j] == 0) || (M[j] > b->lines[j].capacity))
+			return -1;
+	}
+
+	for (size_t j = 0; j < b->N; ++j)
+	{
+		b->fadeM[j] = b->lines[j].M;
+		delayLineSetLength(&b->lines[j], M[j]);
+	}
+
+	b->fadeLength = fadeLength;
+	b->fadePosition = 0;
+
+	return 0;
+}
+
+
+//	line[i] = fadeOut[i] + t * (line[i] - fadeOut[i]), t rising linearly to 1 at the end of the fade
+static void fbcfBankCrossfade(float32_t *line, const float32_t *fadeOut, size_t position, size_t length, size_t n)
+{
+	float32_t step = 1.f / (float32_t)length;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		float32_t t = (float32_t)(position + i + 1) * step;
+		if (t > 1.f)
+			t = 1.f;
+
+		line[i] = fadeOut[i] + (t * (line[i] - fadeOut[i]));
+	}
+}
+
+
+void deleteFBCFBank(FBCFBank *b)
+{
+	if (b == NULL) return;
+
+	if (b->buffer != NULL)
+	{
+		free(b->buffer);
+		b->buffer = NULL;
+	}
+
+	if (b->samples != NULL)
+	{
+		free(b->samples);
+		b->samples = NULL;
+	}
+
+	free(b);
+	b = NULL;
+
+	return;
+}
+
+
+//	Process a block of n samples through every comb in the bank and write the sum of their outputs to y.
+//	x and y may point to the same buffer
+int fbcfBankProcessBlock(FBCFBank *b, const float32_t *x, float32_t *y, size_t n)
+{
+	return fbcfBankProcessBlockInterleaved(b, x, y, 1, n);
+}
+
+
+#if defined(__AVX2__)
+#define FBCF_BANK_VECTOR_SIZE 8
+typedef __m256 FBCFBankVector;
+
+static inline FBCFBankVector fbcfBankLoad(const float32_t *p) { return _mm256_loadu_ps(p); }
+static inline void fbcfBankStore(float32_t *p, FBCFBankVector v) { _mm256_storeu_ps(p, v); }
+static inline FBCFBankVector fbcfBankSplat(float32_t s) { return _mm256_set1_ps(s); }
+static inline FBCFBankVector fbcfBankAdd(FBCFBankVector a, FBCFBankVector b) { return _mm256_add_ps(a, b); }
+static inline FBCFBankVector fbcfBankMul(FBCFBankVector a, FBCFBankVector b) { return _mm256_mul_ps(a, b); }
+#elif defined(__SSE2__) || defined(_M_X64)
+#define FBCF_BANK_VECTOR_SIZE 4
+typedef __m128 FBCFBankVector;
+
+static inline FBCFBankVector fbcfBankLoad(const float32_t *p) { return _mm_loadu_ps(p); }
+static inline void fbcfBankStore(float32_t *p, FBCFBankVector v) { _mm_storeu_ps(p, v); }
+static inline FBCFBankVector fbcfBankSplat(float32_t s) { return _mm_set1_ps(s); }
+static inline FBCFBankVector fbcfBankAdd(FBCFBankVector a, FBCFBankVector b) { return _mm_add_ps(a, b); }
+static inline FBCFBankVector fbcfBankMul(FBCFBankVector a, FBCFBankVector b) { return _mm_mul_ps(a, b); }
+#elif FBCF_BANK_NEON
+//	The same intrinsics exist in arm_neon.h (Cortex-A) and arm_mve.h (Helium, Cortex-M55/M85)
+#define FBCF_BANK_VECTOR_SIZE 4
+typedef float32x4_t FBCFBankVector;
+
+static inline FBCFBankVector fbcfBankLoad(const float32_t *p) { return vld1q_f32(p); }
+static inline void fbcfBankStore(float32_t *p, FBCFBankVector v) { vst1q_f32(p, v); }
+static inline FBCFBankVector fbcfBankSplat(float32_t s) { return vdupq_n_f32(s); }
+static inline FBCFBankVector fbcfBankAdd(FBCFBankVector a, FBCFBankVector b) { return vaddq_f32(a, b); }
+static inline FBCFBankVector fbcfBankMul(FBCFBankVector a, FBCFBankVector b) { return vmulq_f32(a, b); }
+#else
+//	No vector unit (the Cortex-M4F): one sample at a time, which still keeps the output in a register over the combs
+#define FBCF_BANK_VECTOR_SIZE 1
+typedef float32_t FBCFBankVector;
+
+static inline FBCFBankVector fbcfBankLoad(const float32_t *p) { return *p; }
+static inline void fbcfBankStore(float32_t *p, FBCFBankVector v) { *p = v; }
+static inline FBCFBankVector fbcfBankSplat(float32_t s) { return s; }
+static inline FBCFBankVector fbcfBankAdd(FBCFBankVector a, FBCFBankVector b) { return a + b; }
+static inline FBCFBankVector fbcfBankMul(FBCFBankVector a, FBCFBankVector b) { return a * b; }
+#endif
+
+
+//	Advance every comb over a piece of count samples, p[j] being comb j's part of its delay line for the piece.  No line
+//	wraps inside the piece and the piece is no longer than any comb's delay, so none of the samples a comb reads were
+//	written in the same piece and v = x + (am * v[n - M]) can be evaluated for all count samples at once.  The lanes of
+//	a vector are consecutive samples: for each FBCF_BANK_VECTOR_SIZE samples x is loaded once, every comb's samples are
+//	loaded, updated with one multiply-add and stored back, and each output is summed in a register over its combs with
+//	one more multiply-add, so the only memory traffic is one load and one store per comb.  The samples past the last
+//	whole vector are done one at a time
+static void fbcfBankAdvance(const FBCFBank *b, float32_t *const *p, const float32_t *x, float32_t *y, size_t numOutputs, size_t count)
+{
+	size_t lanesPerOutput = b->N / numOutputs;
+	FBCFBankVector am[FBCF_BANK_MAX_COMBS];
+	FBCFBankVector b0[FBCF_BANK_MAX_COMBS];
+	float32_t tile[FBCF_BANK_VECTOR_SIZE * FBCF_BANK_MAX_COMBS];
+	size_t i = 0;
+
+	for (size_t j = 0; j < b->N; ++j)
+	{
+		am[j] = fbcfBankSplat(b->am[j]);
+		b0[j] = fbcfBankSplat(b->b0[j]);
+	}
+
+	for (; i + FBCF_BANK_VECTOR_SIZE <= count; i += FBCF_BANK_VECTOR_SIZE)
+	{
+		FBCFBankVector input = fbcfBankLoad(x + i);
+#if DENORMAL_PROTECTION_DC
+		input = fbcfBankAdd(input, fbcfBankSplat(DENORMAL_DC));
+#endif
+		size_t j = 0;
+
+		for (size_t c = 0; c < numOutputs; ++c)
+		{
+			FBCFBankVector acc = fbcfBankSplat(0.f);
+
+			for (size_t end = j + lanesPerOutput; j < end; ++j)
+			{
+				FBCFBankVector v = fbcfBankAdd(fbcfBankMul(fbcfBankLoad(p[j] + i), am[j]), input);
+
+				fbcfBankStore(p[j] + i, v);
+				acc = fbcfBankAdd(acc, fbcfBankMul(v, b0[j]));
+			}
+
+			fbcfBankStore((numOutputs == 1) ? (y + i) : (tile + (c * FBCF_BANK_VECTOR_SIZE)), acc);
+		}
+
+		//	Interleave the outputs of several channels
+		if (numOutputs > 1)
+		{
+			for (size_t k = 0; k < FBCF_BANK_VECTOR_SIZE; ++k)
+			{
+				for (size_t c = 0; c < numOutputs; ++c)
+					y[((i + k) * numOutputs) + c] = tile[(c * FBCF_BANK_VECTOR_SIZE) + k];
+			}
+		}
+	}
+
+	for (; i < count; ++i)
+	{
+		float32_t input = DENORMAL_PROTECT(x[i]);
+		size_t j = 0;
+
+		for (size_t c = 0; c < numOutputs; ++c)
+		{
+			float32_t acc = 0.f;
+
+			for (size_t end = j + lanesPerOutput; j < end; ++j)
+			{
+				float32_t v = (p[j][i] * b->am[j]) + input;
+
+				p[j][i] = v;
+				acc += v * b->b0[j];
+			}
+
+			y[(i * numOutputs) + c] = acc;
+		}
+	}
+}
+
+
+//	Process a block of n samples through every comb in the bank and produce numOutputs outputs per sample, interleaved
+//	in y (y[i * numOutputs + c]).  The combs are split evenly between the outputs in order: output c is the sum of combs
+//	c * N / numOutputs up to (c + 1) * N / numOutputs - 1.  Every comb gets the same input, so all of the outputs are
+//	produced in one pass over the delay lines.
+//	The block is split wherever one of the delay lines wraps, and every piece is run by fbcfBankAdvance().
+//	N must be a multiple of numOutputs.  x and y may only point to the same buffer when numOutputs is 1
+int fbcfBankProcessBlockInterleaved(FBCFBank *b, const float32_t *x, float32_t *y, size_t numOutputs, size_t n)
+{
+	if ((b == NULL) || (x == NULL) || (y == NULL)) return -1;
+	if ((numOutputs == 0) || ((b->N % numOutputs) != 0)) return -1;
+
+	float32_t *p[FBCF_BANK_MAX_COMBS];
+
+	while (n > 0)
+	{
+		//	Find the longest piece in which none of the delay lines wrap
+		size_t count = n;
+		for (size_t j = 0; j < b->N; ++j)
+			count = delayLineSpan(&b->lines[j], count);
+
+		//	During a fade the old taps are read into a scratch piece first, before acquiring the line can overwrite them
+		int fading = (b->fadePosition < b->fadeLength);
+
+		if (fading)
+		{
+			count = (count > DELAY_LINE_SCRATCH_SIZE) ? DELAY_LINE_SCRATCH_SIZE : count;
+
+			for (size_t j = 0; j < b->N; ++j)
+				count = (b->fadeM[j] < count) ? b->fadeM[j] : count;
+		}
+
+		if (count == 0)
+			return -1;
+
+		for (size_t j = 0; j < b->N; ++j)
+		{
+			if (fading && (b->fadeM[j] != b->lines[j].M))
+			{
+				float32_t fadeOut[DELAY_LINE_SCRATCH_SIZE];
+
+				delayLineReadTap(&b->lines[j], b->fadeM[j], fadeOut, count);
+				p[j] = delayLineAcquire(&b->lines[j], count);
+				fbcfBankCrossfade(p[j], fadeOut, b->fadePosition, b->fadeLength, count);
+			}
+			else
+				p[j] = delayLineAcquire(&b->lines[j], count);
+		}
+
+		if (fading)
+			b->fadePosition += count;
+
+		fbcfBankAdvance(b, p, x, y, numOutputs, count);
+
+		for (size_t j = 0; j < b->N; ++j)
+			delayLineRelease(&b->lines[j], count);
+
+		x += count;
+		y += count * numOutputs;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
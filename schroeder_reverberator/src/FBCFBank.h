@@ -0,0 +1,74 @@
+/*
+ * FBCFBank.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FBCFBANK_H_
+#define SRC_FBCFBANK_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+#include "DelayLine.h"
+#include "Denormal.h"
+
+#if defined(__ARM_NEON)
+#include "arm_neon.h"
+#define FBCF_BANK_NEON 1
+#elif defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#include "arm_mve.h"
+#define FBCF_BANK_NEON 1
+#else
+#define FBCF_BANK_NEON 0
+#endif
+
+
+#define FBCF_BANK_MAX_COMBS 16
+
+
+//	Bank of parallel Feedback Comb Filters that share the same input and whose outputs are summed.
+//	The gains and delay lines are stored as arrays (one entry per comb) so that all of the combs are advanced together
+//	over each piece of the block in one pass, eight samples per vector with AVX2 and four with SSE2, NEON or Helium.
+//	The vectors run along time rather than across combs: every comb's samples for a piece sit next to each other in its
+//	delay line, while one sample of each comb doesn't, so this is what lets one vector load cover a whole vector.  All
+//	of the delay lines share one sample storage format.
+//	The delay lengths can be moved within the lengths the bank was created with by fbcfBankSetLengths(), which fades
+//	each comb from its old tap to its new one over fadeLength samples
+typedef struct
+{
+	size_t N;
+	float32_t b0[FBCF_BANK_MAX_COMBS];
+	float32_t am[FBCF_BANK_MAX_COMBS];
+	DelayLine lines[FBCF_BANK_MAX_COMBS];
+	size_t fadeM[FBCF_BANK_MAX_COMBS];		//	Delays being faded out
+	size_t fadeLength;
+	size_t fadePosition;					//	The fade is over once this reaches fadeLength
+	float32_t *buffer;
+	void *samples;
+}FBCFBank;
+
+
+//	Number of arena bytes used by createFBCFBankInArena(), totalLength being the sum of all of the delay lengths
+#define FBCF_BANK_ARENA_SIZE(totalLength) (ARENA_ALIGN(sizeof(FBCFBank)) + ARENA_ALIGN((totalLength) * sizeof(float32_t)))
+
+//	Number of arena bytes used by createFBCFBankWithFormatInArena() for a compact format
+#define FBCF_BANK_COMPACT_ARENA_SIZE(N, totalLength) (ARENA_ALIGN(sizeof(FBCFBank)) + ARENA_ALIGN((totalLength) * sizeof(uint16_t)) + \
+													ARENA_ALIGN((N) * DELAY_LINE_SCRATCH_SIZE * sizeof(float32_t)))
+
+
+FBCFBank	*createFBCFBank(size_t N, const size_t *M, const float32_t *b0, const float32_t *am);
+FBCFBank	*createFBCFBankWithFormat(size_t N, const size_t *M, const float32_t *b0, const float32_t *am, DelayLineFormat format, float32_t fullScale);
+FBCFBank	*createFBCFBankInArena(Arena *arena, size_t N, const size_t *M, const float32_t *b0, const float32_t *am);
+FBCFBank	*createFBCFBankWithFormatInArena(Arena *arena, size_t N, const size_t *M, const float32_t *b0, const float32_t *am,
+											DelayLineFormat format, float32_t fullScale);
+size_t		fbcfBankArenaSize(size_t N, const size_t *M, DelayLineFormat format);
+void		deleteFBCFBank(FBCFBank *b);
+void		fbcfBankReset(FBCFBank *b);
+int			fbcfBankSetLengths(FBCFBank *b, const size_t *M, size_t fadeLength);
+int			fbcfBankProcessBlock(FBCFBank *b, const float32_t *x, float32_t *y, size_t n);
+int			fbcfBankProcessBlockInterleaved(FBCFBank *b, const float32_t *x, float32_t *y, size_t numOutputs, size_t n);
+
+
+
+#endif /* SRC_FBCFBANK_H_ */
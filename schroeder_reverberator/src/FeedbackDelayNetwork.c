@@ -0,0 +1,266 @@
+/*
+ * FeedbackDelayNetwork.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "FeedbackDelayNetwork.h"
+
+
+//	Returns the sum of the delay lengths, or 0 if the network can't be built with these parameters
+static size_t fdnTotalLength(size_t N, const size_t *M)
+{
+	if (M == NULL)
+		return 0;
+
+	if ((N != 4) && (N != 8) && (N != 16))
+		return 0;
+
+	size_t totalLength = 0;
+	for (size_t j = 0; j < N; ++j)
+	{
+		if (M[j] == 0)
+			return 0;
+
+		totalLength += M[j];
+	}
+
+	return totalLength;
+}
+
+
+//	All of the delay lines are stored back to back in buffer
+static int initFDN(FDN *f, float32_t *buffer, size_t N, const size_t *M, float32_t rt60, float32_t fs)
+{
+	f->N = N;
+	f->buffer = buffer;
+
+	float32_t *line = buffer;
+
+	for (size_t j = 0; j < N; ++j)
+	{
+		if (delayLineInit(&f->lines[j], M[j], DELAY_LINE_FORMAT_F32, 1.f, line, NULL) < 0)
+			return -1;
+
+		line += M[j];
+	}
+
+	return fdnSetRT60(f, rt60, fs);
+}
+
+
+//	N must be 4, 8 or 16.  All N delay lines are allocated as one contiguous buffer
+FDN *createFDN(size_t N, const size_t *M, float32_t rt60, float32_t fs)
+{
+	size_t totalLength = fdnTotalLength(N, M);
+	if (totalLength == 0)
+		return NULL;
+
+	FDN *f = (FDN *)malloc(sizeof(FDN));
+	if (f == NULL)
+		return NULL;
+
+	float32_t *buffer = (float32_t *)malloc(sizeof(float32_t) * totalLength);
+
+	if ((buffer == NULL) || (initFDN(f, buffer, N, M, rt60, fs) < 0))
+	{
+		free(buffer);
+		free(f);
+		return NULL;
+	}
+
+	return f;
+}
+
+
+FDN *createFDNInArena(Arena *arena, size_t N, const size_t *M, float32_t rt60, float32_t fs)
+{
+	size_t totalLength = fdnTotalLength(N, M);
+	if (totalLength == 0)
+		return NULL;
+
+	FDN *f = (FDN *)arenaAlloc(arena, sizeof(FDN));
+	if (f == NULL)
+		return NULL;
+
+	float32_t *buffer = (float32_t *)arenaAlloc(arena, sizeof(float32_t) * totalLength);
+	if (buffer == NULL)
+		return NULL;
+
+	if (initFDN(f, buffer, N, M, rt60, fs) < 0)
+		return NULL;
+
+	return f;
+}
+
+
+size_t fdnArenaSize(size_t N, const size_t *M)
+{
+	return FDN_ARENA_SIZE(fdnTotalLength(N, M));
+}
+
+
+void deleteFDN(FDN *f)
+{
+	if (f == NULL) return;
+
+	if (f->buffer != NULL)
+	{
+		free(f->buffer);
+		f->buffer = NULL;
+	}
+
+	free(f);
+	f = NULL;
+
+	return;
+}
+
+
+//	Clear every delay line back to silence
+void fdnReset(FDN *f)
+{
+	if (f == NULL) return;
+
+	for (size_t j = 0; j < f->N; ++j)
+		delayLineReset(&f->lines[j]);
+
+	return;
+}
+
+
+//	Set every line's feedback gain for a reverberation time of rt60 seconds.  A line of M samples is passed through
+//	once every M / fs seconds, so it needs g = 10^(-3M / (fs * rt60)) to lose 60 dB in rt60 seconds.  The gains are
+//	computed together as g = 2^(k * M) with k = -3 * log2(10) / (fs * rt60)
+int fdnSetRT60(FDN *f, float32_t rt60, float32_t fs)
+{
+	if (f == NULL) return -1;
+	if ((rt60 <= 0.f) || (fs <= 0.f)) return -1;
+
+	float32_t k = (-3.f * 3.321928095f) / (fs * rt60);
+
+	//	The Hadamard matrix is normalized by 1 / sqrt(N) so that it is lossless
+	float32_t normalization = 1.f / sqrtf((float32_t)f->N);
+
+	for (size_t j = 0; j < f->N; ++j)
+		f->g[j] = exp2f(k * (float32_t)f->lines[j].M) * normalization;
+
+	return 0;
+}
+
+
+//	In-place fast Walsh-Hadamard transform of N values.  N must be a power of two
+static inline void fdnHadamard(float32_t *v, size_t N)
+{
+	for (size_t h = 1; h < N; h <<= 1)
+	{
+		for (size_t i = 0; i < N; i += (h << 1))
+		{
+			for (size_t j = i; j < (i + h); ++j)
+			{
+				float32_t a = v[j];
+				float32_t b = v[j + h];
+
+				v[j] = a + b;
+				v[j + h] = a - b;
+			}
+		}
+	}
+}
+
+
+//	Process count samples in which none of the delay lines wrap.  p[j][i] is line j's output for sample i, and is
+//	overwritten with the line's new input.  Called with a constant N so that the transform is fully unrolled
+static inline void fdnProcessPiece(float32_t **p, const float32_t *g, const float32_t *x, float32_t *y, size_t count, size_t N)
+{
+	float32_t s[FDN_MAX_LINES];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		float32_t input = DENORMAL_PROTECT(x[i]);
+		float32_t acc0 = 0.f;
+		float32_t acc1 = 0.f;
+		float32_t acc2 = 0.f;
+		float32_t acc3 = 0.f;
+
+		for (size_t j = 0; j < N; j += 4)
+		{
+			float32_t s0 = p[j][i];
+			float32_t s1 = p[j + 1][i];
+			float32_t s2 = p[j + 2][i];
+			float32_t s3 = p[j + 3][i];
+
+			acc0 += s0;
+			acc1 += s1;
+			acc2 += s2;
+			acc3 += s3;
+
+			s[j] = s0 * g[j];
+			s[j + 1] = s1 * g[j + 1];
+			s[j + 2] = s2 * g[j + 2];
+			s[j + 3] = s3 * g[j + 3];
+		}
+
+		y[i] = (acc0 + acc1) + (acc2 + acc3);
+
+		fdnHadamard(s, N);
+
+		for (size_t j = 0; j < N; ++j)
+			p[j][i] = s[j] + input;
+	}
+}
+
+
+//	Process a block of n samples through the network.  The block is split wherever one of the delay lines wraps.
+//	Inside each piece, for every sample: read each line's output s, sum them into y, then write
+//	x + (H * (g * s)) back into the lines.  x and y may point to the same buffer
+int fdnProcessBlock(FDN *f, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((f == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DenormalState denormalState = denormalGuardBegin();
+
+	size_t N = f->N;
+	float32_t g[FDN_MAX_LINES];
+	float32_t *p[FDN_MAX_LINES];
+
+	for (size_t j = 0; j < N; ++j)
+		g[j] = f->g[j];
+
+	while (n > 0)
+	{
+		//	Find the longest piece in which none of the delay lines wrap
+		size_t count = n;
+		for (size_t j = 0; j < N; ++j)
+			count = delayLineSpan(&f->lines[j], count);
+
+		if (count == 0)
+		{
+			denormalGuardEnd(denormalState);
+			return -1;
+		}
+
+		for (size_t j = 0; j < N; ++j)
+			p[j] = delayLineAcquire(&f->lines[j], count);
+
+		if (N == 4)
+			fdnProcessPiece(p, g, x, y, count, 4);
+		else if (N == 8)
+			fdnProcessPiece(p, g, x, y, count, 8);
+		else
+			fdnProcessPiece(p, g, x, y, count, 16);
+
+		for (size_t j = 0; j < N; ++j)
+			delayLineRelease(&f->lines[j], count);
+
+		x += count;
+		y += count;
+		n -= count;
+	}
+
+	denormalGuardEnd(denormalState);
+
+	return 0;
+}
+
+
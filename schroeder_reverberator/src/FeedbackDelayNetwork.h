@@ -0,0 +1,47 @@
+/*
+ * FeedbackDelayNetwork.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_FEEDBACKDELAYNETWORK_H_
+#define SRC_FEEDBACKDELAYNETWORK_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+#include "DelayLine.h"
+#include "Denormal.h"
+
+
+#define FDN_MAX_LINES 16
+
+
+//	Feedback Delay Network.  N delay lines (4, 8 or 16) all take the input, and the outputs of the lines are fed back
+//	into every line through a normalized Hadamard matrix, which is applied as a fast Walsh-Hadamard transform in
+//	N log2(N) additions.  The output is the sum of the delay line outputs.  Each line's feedback gain g is set from the
+//	reverberation time so that every line decays by 60 dB in RT60 seconds
+typedef struct
+{
+	size_t N;
+	float32_t g[FDN_MAX_LINES];			//	Feedback gains, with the 1 / sqrt(N) matrix normalization folded in
+	DelayLine lines[FDN_MAX_LINES];
+	float32_t *buffer;
+}FDN;
+
+
+//	Number of arena bytes used by createFDNInArena(), totalLength being the sum of all of the delay lengths
+#define FDN_ARENA_SIZE(totalLength) (ARENA_ALIGN(sizeof(FDN)) + ARENA_ALIGN((totalLength) * sizeof(float32_t)))
+
+
+FDN			*createFDN(size_t N, const size_t *M, float32_t rt60, float32_t fs);
+FDN			*createFDNInArena(Arena *arena, size_t N, const size_t *M, float32_t rt60, float32_t fs);
+size_t		fdnArenaSize(size_t N, const size_t *M);
+void		deleteFDN(FDN *f);
+void		fdnReset(FDN *f);
+int			fdnSetRT60(FDN *f, float32_t rt60, float32_t fs);
+int			fdnProcessBlock(FDN *f, const float32_t *x, float32_t *y, size_t n);
+
+
+
+#endif /* SRC_FEEDBACKDELAYNETWORK_H_ */
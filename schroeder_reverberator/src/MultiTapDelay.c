@@ -0,0 +1,211 @@
+/*
+ * MultiTapDelay.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "MultiTapDelay.h"
+
+
+//	Returns the buffer length needed for these taps, or 0 if they are invalid
+static size_t multiTapDelayLength(const size_t *delays, size_t numTaps, size_t maxBlockSize)
+{
+	if ((delays == NULL) || (numTaps == 0) || (numTaps > MULTI_TAP_DELAY_MAX_TAPS) || (maxBlockSize == 0))
+		return 0;
+
+	size_t maxDelay = 0;
+	for (size_t k = 0; k < numTaps; ++k)
+	{
+		if (delays[k] > maxDelay)
+			maxDelay = delays[k];
+	}
+
+	return maxDelay + maxBlockSize;
+}
+
+
+//	Store the taps sorted by delay so that consecutive taps read neighbouring parts of the buffer
+static void initMultiTapDelay(MultiTapDelay *m, float32_t *buffer, size_t length, const size_t *delays, const float32_t *gains, size_t numTaps,
+								size_t maxBlockSize)
+{
+	m->buffer = buffer;
+	m->length = length;
+	m->writePtr = 0;
+	m->maxBlockSize = maxBlockSize;
+	m->numTaps = numTaps;
+
+	arm_fill_f32(0.f, m->buffer, length);
+
+	for (size_t k = 0; k < numTaps; ++k)
+	{
+		size_t j = k;
+
+		while ((j > 0) && (m->delay[j - 1] > delays[k]))
+		{
+			m->delay[j] = m->delay[j - 1];
+			m->gain[j] = m->gain[j - 1];
+			--j;
+		}
+
+		m->delay[j] = delays[k];
+		m->gain[j] = gains[k];
+	}
+}
+
+
+MultiTapDelay *createMultiTapDelay(const size_t *delays, const float32_t *gains, size_t numTaps, size_t maxBlockSize)
+{
+	if (gains == NULL)
+		return NULL;
+
+	size_t length = multiTapDelayLength(delays, numTaps, maxBlockSize);
+	if (length == 0)
+		return NULL;
+
+	MultiTapDelay *m = (MultiTapDelay *)malloc(sizeof(MultiTapDelay));
+	if (m == NULL)
+		return NULL;
+
+	float32_t *buffer = (float32_t *)malloc(sizeof(float32_t) * length);
+	if (buffer == NULL)
+	{
+		free(m);
+		return NULL;
+	}
+
+	initMultiTapDelay(m, buffer, length, delays, gains, numTaps, maxBlockSize);
+
+	return m;
+}
+
+
+MultiTapDelay *createMultiTapDelayInArena(Arena *arena, const size_t *delays, const float32_t *gains, size_t numTaps, size_t maxBlockSize)
+{
+	if (gains == NULL)
+		return NULL;
+
+	size_t length = multiTapDelayLength(delays, numTaps, maxBlockSize);
+	if (length == 0)
+		return NULL;
+
+	MultiTapDelay *m = (MultiTapDelay *)arenaAlloc(arena, sizeof(MultiTapDelay));
+	if (m == NULL)
+		return NULL;
+
+	float32_t *buffer = (float32_t *)arenaAlloc(arena, sizeof(float32_t) * length);
+	if (buffer == NULL)
+		return NULL;
+
+	initMultiTapDelay(m, buffer, length, delays, gains, numTaps, maxBlockSize);
+
+	return m;
+}
+
+
+size_t multiTapDelayArenaSize(const size_t *delays, size_t numTaps, size_t maxBlockSize)
+{
+	return ARENA_ALIGN(sizeof(MultiTapDelay)) + ARENA_ALIGN(sizeof(float32_t) * multiTapDelayLength(delays, numTaps, maxBlockSize));
+}
+
+
+void deleteMultiTapDelay(MultiTapDelay *m)
+{
+	if (m == NULL) return;
+
+	if (m->buffer != NULL)
+	{
+		free(m->buffer);
+		m->buffer = NULL;
+	}
+
+	free(m);
+	m = NULL;
+
+	return;
+}
+
+
+//	Add the taps first..first + numTaps - 1 (at most four) into y.  r holds each tap's read position.  The block is split
+//	wherever one of the taps wraps, and inside each piece the taps are summed together so y is only read and written once
+//	per group of four taps
+static void multiTapAccumulate(MultiTapDelay *m, size_t first, size_t numTaps, size_t *r, float32_t *y, size_t n)
+{
+	float32_t g[4] = {0.f, 0.f, 0.f, 0.f};
+	float32_t *p[4];
+
+	for (size_t k = 0; k < numTaps; ++k)
+		g[k] = m->gain[first + k];
+
+	while (n > 0)
+	{
+		size_t count = n;
+		for (size_t k = 0; k < numTaps; ++k)
+		{
+			if (m->length - r[k] < count)
+				count = m->length - r[k];
+		}
+
+		//	Unused lanes read from the first tap with a gain of zero
+		for (size_t k = 0; k < 4; ++k)
+			p[k] = &m->buffer[r[(k < numTaps) ? k : 0]];
+
+		for (size_t i = 0; i < count; ++i)
+			y[i] += ((g[0] * p[0][i]) + (g[1] * p[1][i])) + ((g[2] * p[2][i]) + (g[3] * p[3][i]));
+
+		for (size_t k = 0; k < numTaps; ++k)
+		{
+			r[k] += count;
+			if (r[k] >= m->length)
+				r[k] -= m->length;
+		}
+
+		y += count;
+		n -= count;
+	}
+}
+
+
+//	Write the block into the delay line, then add up every tap over the whole block.  Taps are read four at a time, so
+//	the block costs one pass over y per four taps instead of one delay line and one pass per tap.  n must not exceed
+//	maxBlockSize.  x and y may point to the same buffer
+int multiTapDelayProcessBlock(MultiTapDelay *m, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((m == NULL) || (x == NULL) || (y == NULL)) return -1;
+	if (n > m->maxBlockSize) return -1;
+
+	//	Write the input block
+	size_t start = m->writePtr;
+	size_t count = m->length - start;
+	if (count > n)
+		count = n;
+
+	arm_copy_f32((float32_t *)x, &m->buffer[start], count);
+	arm_copy_f32((float32_t *)x + count, m->buffer, n - count);
+
+	//	Sum the taps.  Tap k reads the samples written delay[k] samples before the block
+	arm_fill_f32(0.f, y, n);
+
+	for (size_t k = 0; k < m->numTaps; k += 4)
+	{
+		size_t r[4];
+		size_t numTaps = m->numTaps - k;
+		if (numTaps > 4)
+			numTaps = 4;
+
+		for (size_t j = 0; j < numTaps; ++j)
+		{
+			size_t delay = m->delay[k + j];
+			r[j] = (start >= delay) ? (start - delay) : (start + m->length - delay);
+		}
+
+		multiTapAccumulate(m, k, numTaps, r, y, n);
+	}
+
+	m->writePtr = start + n;
+	if (m->writePtr >= m->length)
+		m->writePtr -= m->length;
+
+	return 0;
+}
+
+
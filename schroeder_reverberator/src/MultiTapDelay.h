@@ -0,0 +1,41 @@
+/*
+ * MultiTapDelay.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_MULTITAPDELAY_H_
+#define SRC_MULTITAPDELAY_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+
+
+#define MULTI_TAP_DELAY_MAX_TAPS 64
+
+
+//	One delay line read by up to MULTI_TAP_DELAY_MAX_TAPS taps, each with its own delay and gain.  The output is the
+//	weighted sum of all of the taps, e.g. for early reflections or a multi-tap echo.  The buffer holds the longest delay
+//	plus one block so that a whole block can be written before any of the taps are read
+typedef struct
+{
+	float32_t *buffer;
+	size_t length;
+	size_t writePtr;
+	size_t maxBlockSize;
+	size_t numTaps;
+	size_t delay[MULTI_TAP_DELAY_MAX_TAPS];
+	float32_t gain[MULTI_TAP_DELAY_MAX_TAPS];
+}MultiTapDelay;
+
+
+MultiTapDelay	*createMultiTapDelay(const size_t *delays, const float32_t *gains, size_t numTaps, size_t maxBlockSize);
+MultiTapDelay	*createMultiTapDelayInArena(Arena *arena, const size_t *delays, const float32_t *gains, size_t numTaps, size_t maxBlockSize);
+size_t			multiTapDelayArenaSize(const size_t *delays, size_t numTaps, size_t maxBlockSize);
+void			deleteMultiTapDelay(MultiTapDelay *m);
+int				multiTapDelayProcessBlock(MultiTapDelay *m, const float32_t *x, float32_t *y, size_t n);
+
+
+
+#endif /* SRC_MULTITAPDELAY_H_ */
@@ -0,0 +1,238 @@
+/*
+ * PartitionedConvolver.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "PartitionedConvolver.h"
+
+
+//	Returns the number of partitions the impulse response is cut into, or 0 if the convolver can't be built with these
+//	parameters.  blockSize has to be a power of two so that fftSize is one too
+static size_t partitionedConvolverNumPartitions(size_t irLength, size_t blockSize)
+{
+	if ((irLength == 0) || (blockSize < 16) || (2 * blockSize > PARTITIONED_CONVOLVER_MAX_FFT_SIZE))
+		return 0;
+
+	if ((blockSize & (blockSize - 1)) != 0)
+		return 0;
+
+	return (irLength + blockSize - 1) / blockSize;
+}
+
+
+//	Number of floats in the convolver's buffer: the partition spectra and the delay line, then window, acc and scratch
+static size_t partitionedConvolverBufferLength(size_t numPartitions, size_t blockSize)
+{
+	return ((2 * numPartitions) + 3) * 2 * blockSize;
+}
+
+
+size_t partitionedConvolverArenaSize(size_t irLength, size_t blockSize)
+{
+	size_t numPartitions = partitionedConvolverNumPartitions(irLength, blockSize);
+	if (numPartitions == 0)
+		return 0;
+
+	size_t bufferSize = (sizeof(float32_t) * partitionedConvolverBufferLength(numPartitions, blockSize)) + PARTITIONED_CONVOLVER_ALIGNMENT - 1;
+
+	return ARENA_ALIGN(sizeof(PartitionedConvolver)) + ARENA_ALIGN(bufferSize);
+}
+
+
+PartitionedConvolver *createPartitionedConvolverInArena(Arena *arena, const float32_t *ir, size_t irLength, size_t blockSize)
+{
+	if (ir == NULL)
+		return NULL;
+
+	size_t numPartitions = partitionedConvolverNumPartitions(irLength, blockSize);
+	if (numPartitions == 0)
+		return NULL;
+
+	PartitionedConvolver *c = (PartitionedConvolver *)arenaAlloc(arena, sizeof(PartitionedConvolver));
+	if (c == NULL)
+		return NULL;
+
+	size_t fftSize = 2 * blockSize;
+	size_t bufferSize = (sizeof(float32_t) * partitionedConvolverBufferLength(numPartitions, blockSize)) + PARTITIONED_CONVOLVER_ALIGNMENT - 1;
+
+	uint8_t *buffer = (uint8_t *)arenaAlloc(arena, bufferSize);
+	if (buffer == NULL)
+		return NULL;
+
+	//	Every part of the buffer is a multiple of fftSize floats long, so aligning the start aligns all of them
+	uintptr_t misalignment = (uintptr_t)buffer % PARTITIONED_CONVOLVER_ALIGNMENT;
+	if (misalignment != 0)
+		buffer += PARTITIONED_CONVOLVER_ALIGNMENT - misalignment;
+
+	if (arm_rfft_fast_init_f32(&c->fft, (uint16_t)fftSize) != ARM_MATH_SUCCESS)
+		return NULL;
+
+	c->blockSize = blockSize;
+	c->fftSize = fftSize;
+	c->numPartitions = numPartitions;
+	c->spectra = (float32_t *)buffer;
+	c->fdl = c->spectra + (numPartitions * fftSize);
+	c->window = c->fdl + (numPartitions * fftSize);
+	c->acc = c->window + fftSize;
+	c->scratch = c->acc + fftSize;
+	c->memory = NULL;
+
+	//	Partition p holds ir[p * blockSize] up to ir[((p + 1) * blockSize) - 1], zero-padded to fftSize.  The last one
+	//	is also zero-padded up to blockSize if the impulse response doesn't fill it
+	for (size_t p = 0; p < numPartitions; ++p)
+	{
+		size_t offset = p * blockSize;
+		size_t length = ((irLength - offset) < blockSize) ? (irLength - offset) : blockSize;
+
+		arm_fill_f32(0.f, c->scratch, fftSize);
+		arm_copy_f32((float32_t *)(ir + offset), c->scratch, length);
+		arm_rfft_fast_f32(&c->fft, c->scratch, c->spectra + (p * fftSize), 0);
+	}
+
+	partitionedConvolverReset(c);
+
+	return c;
+}
+
+
+//	The whole convolver is allocated as one block of memory
+PartitionedConvolver *createPartitionedConvolver(const float32_t *ir, size_t irLength, size_t blockSize)
+{
+	size_t size = partitionedConvolverArenaSize(irLength, blockSize);
+	if (size == 0)
+		return NULL;
+
+	void *memory = malloc(size);
+	if (memory == NULL)
+		return NULL;
+
+	Arena arena;
+	PartitionedConvolver *c = NULL;
+
+	if (arenaInit(&arena, memory, size) == 0)
+		c = createPartitionedConvolverInArena(&arena, ir, irLength, blockSize);
+
+	if (c == NULL)
+	{
+		free(memory);
+		return NULL;
+	}
+
+	c->memory = memory;
+
+	return c;
+}
+
+
+//	Only for convolvers made with createPartitionedConvolver().  The struct itself lives in c->memory
+void deletePartitionedConvolver(PartitionedConvolver *c)
+{
+	if (c == NULL) return;
+
+	free(c->memory);
+	c = NULL;
+
+	return;
+}
+
+
+//	Clear the input history and the delay line back to silence
+void partitionedConvolverReset(PartitionedConvolver *c)
+{
+	if (c == NULL) return;
+
+	arm_fill_f32(0.f, c->fdl, c->numPartitions * c->fftSize);
+	arm_fill_f32(0.f, c->window, c->fftSize);
+	c->fdlHead = 0;
+
+	return;
+}
+
+
+//	acc += X * H over fftSize floats of packed spectra.  The first two floats are the real DC and Nyquist bins, the rest
+//	are complex pairs.  The whole spectrum is run through the complex loop and the two real bins are fixed up after.
+//	With SSE two complex bins are done per vector: re = (xr * hr) - (xi * hi), im = (xi * hr) + (xr * hi)
+static void partitionedConvolverMAC(float32_t *acc, const float32_t *X, const float32_t *H, size_t fftSize)
+{
+	float32_t dc = acc[0] + (X[0] * H[0]);
+	float32_t nyquist = acc[1] + (X[1] * H[1]);
+
+#if defined(__SSE__) || defined(_M_X64)
+	const __m128 sign = _mm_set_ps(1.f, -1.f, 1.f, -1.f);
+
+	for (size_t k = 0; k < fftSize; k += 4)
+	{
+		__m128 x = _mm_load_ps(X + k);
+		__m128 h = _mm_load_ps(H + k);
+		__m128 hr = _mm_shuffle_ps(h, h, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 hi = _mm_shuffle_ps(h, h, _MM_SHUFFLE(3, 3, 1, 1));
+		__m128 xSwapped = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+
+		__m128 product = _mm_add_ps(_mm_mul_ps(x, hr), _mm_mul_ps(_mm_mul_ps(xSwapped, hi), sign));
+		_mm_store_ps(acc + k, _mm_add_ps(_mm_load_ps(acc + k), product));
+	}
+#else
+	for (size_t k = 0; k < fftSize; k += 2)
+	{
+		float32_t xr = X[k];
+		float32_t xi = X[k + 1];
+		float32_t hr = H[k];
+		float32_t hi = H[k + 1];
+
+		acc[k] += (xr * hr) - (xi * hi);
+		acc[k + 1] += (xi * hr) + (xr * hi);
+	}
+#endif
+
+	acc[0] = dc;
+	acc[1] = nyquist;
+}
+
+
+//	Convolve a block of n samples with the impulse response.  n must be a multiple of blockSize.  x and y may point to
+//	the same buffer
+int partitionedConvolverProcessBlock(PartitionedConvolver *c, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((c == NULL) || (x == NULL) || (y == NULL)) return -1;
+	if ((n % c->blockSize) != 0) return -1;
+
+	size_t B = c->blockSize;
+	size_t L = c->fftSize;
+	size_t P = c->numPartitions;
+
+	for (; n > 0; n -= B)
+	{
+		//	Slide the window along by one block
+		arm_copy_f32(c->window + B, c->window, B);
+		arm_copy_f32((float32_t *)x, c->window + B, B);
+
+		//	The delay line runs backwards, so partition p pairs with slot (fdlHead + p) % P
+		c->fdlHead = (c->fdlHead == 0) ? (P - 1) : (c->fdlHead - 1);
+
+		//	arm_rfft_fast_f32 overwrites its input
+		arm_copy_f32(c->window, c->scratch, L);
+		arm_rfft_fast_f32(&c->fft, c->scratch, c->fdl + (c->fdlHead * L), 0);
+
+		arm_fill_f32(0.f, c->acc, L);
+
+		size_t p = 0;
+		for (size_t slot = c->fdlHead; slot < P; ++slot, ++p)
+			partitionedConvolverMAC(c->acc, c->fdl + (slot * L), c->spectra + (p * L), L);
+
+		for (size_t slot = 0; slot < c->fdlHead; ++slot, ++p)
+			partitionedConvolverMAC(c->acc, c->fdl + (slot * L), c->spectra + (p * L), L);
+
+		arm_rfft_fast_f32(&c->fft, c->acc, c->scratch, 1);
+
+		//	The first half of the result wrapped around, the second half is the output for this block
+		arm_copy_f32(c->scratch + B, y, B);
+
+		x += B;
+		y += B;
+	}
+
+	return 0;
+}
+
+
@@ -0,0 +1,58 @@
+/*
+ * PartitionedConvolver.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_PARTITIONEDCONVOLVER_H_
+#define SRC_PARTITIONEDCONVOLVER_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include "xmmintrin.h"
+#endif
+
+
+//	Largest FFT arm_rfft_fast_f32 supports, so blockSize can be up to half of it
+#define PARTITIONED_CONVOLVER_MAX_FFT_SIZE 4096
+
+//	The spectra are aligned for vector loads
+#define PARTITIONED_CONVOLVER_ALIGNMENT 16
+
+
+//	Convolution reverb for long (measured) impulse responses, with uniformly partitioned overlap-save.
+//	The impulse response is cut into numPartitions partitions of blockSize samples and the spectrum of each one,
+//	zero-padded to fftSize = 2 * blockSize, is computed when the convolver is created.  The spectra of the last
+//	numPartitions input blocks are kept in a frequency-domain delay line, so every block costs one FFT of the new input,
+//	one complex multiply-accumulate per partition and one inverse FFT.  The output of a block is produced by the same
+//	call, so the only latency is the block itself.
+//	The partition spectra, the delay line and the work buffers are one contiguous allocation aligned to
+//	PARTITIONED_CONVOLVER_ALIGNMENT
+typedef struct
+{
+	size_t blockSize;
+	size_t fftSize;
+	size_t numPartitions;
+	size_t fdlHead;				//	Slot of the newest input spectrum
+	arm_rfft_fast_instance_f32 fft;
+	float32_t *spectra;			//	numPartitions * fftSize, in arm_rfft_fast_f32's packed format
+	float32_t *fdl;				//	numPartitions * fftSize
+	float32_t *window;			//	Previous input block followed by the current one, fftSize
+	float32_t *acc;				//	fftSize
+	float32_t *scratch;			//	fftSize
+	void *memory;				//	Block everything was allocated from by createPartitionedConvolver(), NULL if created in an arena
+}PartitionedConvolver;
+
+
+PartitionedConvolver	*createPartitionedConvolver(const float32_t *ir, size_t irLength, size_t blockSize);
+PartitionedConvolver	*createPartitionedConvolverInArena(Arena *arena, const float32_t *ir, size_t irLength, size_t blockSize);
+size_t					partitionedConvolverArenaSize(size_t irLength, size_t blockSize);
+void					deletePartitionedConvolver(PartitionedConvolver *c);
+void					partitionedConvolverReset(PartitionedConvolver *c);
+int						partitionedConvolverProcessBlock(PartitionedConvolver *c, const float32_t *x, float32_t *y, size_t n);
+
+
+#endif /* SRC_PARTITIONEDCONVOLVER_H_ */
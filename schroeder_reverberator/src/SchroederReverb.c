@@ -0,0 +1,588 @@
+/*
+ * SchroederReverb.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "SchroederReverb.h"
+
+
+static int schroederReverbConfigValid(const SchroederReverbConfig *c)
+{
+	if (c == NULL)
+		return 0;
+
+	if ((c->apDelayLengths == NULL) || (c->fbDelayLengths == NULL) || (c->fbGains == NULL))
+		return 0;
+
+	if ((c->numAPCFs == 0) || (c->numAPCFs > SCHROEDER_REVERB_MAX_APCFS))
+		return 0;
+
+	if ((c->numChannels == 0) || (c->numChannels > SCHROEDER_REVERB_MAX_CHANNELS))
+		return 0;
+
+	//	Every channel's FBCFs are lanes of the same bank, so fbDelayLengths needs a real delay for each of them
+	if ((c->numFBCFs == 0) || ((c->numFBCFs * c->numChannels) > SCHROEDER_REVERB_MAX_FBCFS))
+		return 0;
+
+	for (size_t j = 0; j < (c->numFBCFs * c->numChannels); ++j)
+	{
+		if (c->fbDelayLengths[j] == 0)
+			return 0;
+	}
+
+	//	The allpass cascade needs a real delay in every stage
+	for (size_t i = 0; i < c->numAPCFs; ++i)
+	{
+		if (c->apDelayLengths[i] == 0)
+			return 0;
+	}
+
+	return c->maxBlockSize > 0;
+}
+
+
+//	Length each FBCF delay line is allocated with, so that it can grow up to maxRoomSize
+static void schroederReverbCapacities(const SchroederReverbConfig *c, size_t *capacity)
+{
+	float32_t maxRoomSize = (c->maxRoomSize > 1.f) ? c->maxRoomSize : 1.f;
+
+	for (size_t j = 0; j < (c->numFBCFs * c->numChannels); ++j)
+		capacity[j] = (size_t)ceilf((float32_t)c->fbDelayLengths[j] * maxRoomSize);
+}
+
+
+//	Work out the reverb tail for the silence gate from the slowest decaying filter.  The APCF_T2 cascade can be up to
+//	(1 + g) / (1 - g) louder than its input per stage, and every FBCF up to 1 / (1 - |am|)
+static void schroederReverbUpdateSilenceGate(SchroederReverb *r)
+{
+	if (!r->gate)
+		return;
+
+	size_t minTail = 0;
+	size_t maxFBLength = 0;
+	float32_t decayTime = 0.f;
+	float32_t apGain = 1.f;
+	float32_t fbGain = 0.f;
+
+	for (size_t i = 0; i < r->numAPCFs; ++i)
+	{
+		float32_t t = silenceGateDecayTime(r->ap[i]->am, r->ap[i]->M->M);
+
+		minTail += r->ap[i]->M->M;
+		decayTime = (t > decayTime) ? t : decayTime;
+		apGain *= silenceGateLoopGain(r->ap[i]->am) * (1.f + fabsf(r->ap[i]->am));
+	}
+
+	for (size_t j = 0; j < r->fb->N; ++j)
+	{
+		float32_t t = silenceGateDecayTime(r->fbTargetAm[j], r->fb->lines[j].M);
+
+		maxFBLength = (r->fb->lines[j].M > maxFBLength) ? r->fb->lines[j].M : maxFBLength;
+		decayTime = (t > decayTime) ? t : decayTime;
+		fbGain += silenceGateLoopGain(r->fbTargetAm[j]);
+	}
+
+	silenceGateSetDecay(&r->silence, minTail + maxFBLength, decayTime, apGain * fbGain);
+
+	//	DC gains: (1 + b0) / (1 - am) through each APCF_T2 and b0 / (1 - am) through each FBCF, then the mixing matrix
+	float32_t apDCGain = 1.f;
+	float32_t channelGain[SCHROEDER_REVERB_MAX_CHANNELS];
+	size_t lanesPerChannel = r->fb->N / r->numChannels;
+
+	for (size_t i = 0; i < r->numAPCFs; ++i)
+		apDCGain *= (1.f + r->ap[i]->b0) / (1.f - r->ap[i]->am);
+
+	for (size_t c = 0; c < r->numChannels; ++c)
+	{
+		channelGain[c] = 0.f;
+
+		for (size_t j = c * lanesPerChannel; j < ((c + 1) * lanesPerChannel); ++j)
+			channelGain[c] += r->fb->b0[j] / (1.f - r->fbTargetAm[j]);
+
+		channelGain[c] *= apDCGain;
+	}
+
+	for (size_t c = 0; c < r->numChannels; ++c)
+	{
+		r->dcGain[c] = channelGain[c];
+
+		if (r->mix)
+		{
+			r->dcGain[c] = 0.f;
+
+			for (size_t k = 0; k < r->numChannels; ++k)
+				r->dcGain[c] += r->mixMatrix[(c * r->numChannels) + k] * channelGain[k];
+		}
+	}
+}
+
+
+size_t schroederReverbArenaSize(const SchroederReverbConfig *c)
+{
+	if (!schroederReverbConfigValid(c))
+		return 0;
+
+	size_t size = SCHROEDER_REVERB_BASE_ARENA_SIZE(c->maxBlockSize);
+
+	for (size_t i = 0; i < c->numAPCFs; ++i)
+		size += APCF_T2_ARENA_SIZE(c->apDelayLengths[i]);
+
+	size_t capacity[SCHROEDER_REVERB_MAX_FBCFS];
+	schroederReverbCapacities(c, capacity);
+
+	return size + fbcfBankArenaSize(c->numFBCFs * c->numChannels, capacity, c->fbFormat);
+}
+
+
+SchroederReverb *createSchroederReverbInArena(Arena *arena, const SchroederReverbConfig *c)
+{
+	if (!schroederReverbConfigValid(c))
+		return NULL;
+
+	SchroederReverb *r = (SchroederReverb *)arenaAlloc(arena, sizeof(SchroederReverb));
+	if (r == NULL)
+		return NULL;
+
+	r->numAPCFs = c->numAPCFs;
+	r->numFBCFs = c->numFBCFs;
+	r->numChannels = c->numChannels;
+	r->maxBlockSize = c->maxBlockSize;
+	r->fs = c->fs;
+	r->rt60 = 0.f;
+	r->fbRamp = 0;
+	r->wet = 1.f;
+	r->dry = 0.f;
+	r->wetTarget = 1.f;
+	r->dryTarget = 0.f;
+	r->paramSequence = 0;
+	r->appliedSequence = 0;
+	r->memory = NULL;
+
+	r->mix = (c->mixMatrix != NULL);
+	if (r->mix)
+	{
+		for (size_t k = 0; k < (c->numChannels * c->numChannels); ++k)
+			r->mixMatrix[k] = c->mixMatrix[k];
+	}
+
+	r->scratch = (float32_t *)arenaAlloc(arena, sizeof(float32_t) * c->maxBlockSize);
+	if (r->scratch == NULL)
+		return NULL;
+
+	for (size_t i = 0; i < c->numAPCFs; ++i)
+	{
+		r->ap[i] = createAPCFT2InArena(arena, c->apDelayLengths[i], -c->apGain, c->apGain);
+		if (r->ap[i] == NULL)
+			return NULL;
+	}
+
+	float32_t outputGains[SCHROEDER_REVERB_MAX_FBCFS];
+	float32_t feedbackGains[SCHROEDER_REVERB_MAX_FBCFS];
+
+	size_t numLanes = c->numFBCFs * c->numChannels;
+
+	size_t capacity[SCHROEDER_REVERB_MAX_FBCFS];
+
+	schroederReverbCapacities(c, capacity);
+
+	for (size_t i = 0; i < numLanes; ++i)
+	{
+		outputGains[i] = 1.f;
+		feedbackGains[i] = -c->fbGains[i];
+		r->fbBaseLength[i] = c->fbDelayLengths[i];
+	}
+
+	r->fb = createFBCFBankWithFormatInArena(arena, numLanes, capacity, outputGains, feedbackGains, c->fbFormat, c->fbFullScale);
+	if (r->fb == NULL)
+		return NULL;
+
+	for (size_t i = 0; i < numLanes; ++i)
+		r->fbTargetAm[i] = feedbackGains[i];
+
+	//	Start at a room size of 1
+	for (size_t i = 0; i < numLanes; ++i)
+	{
+		if (delayLineSetLength(&r->fb->lines[i], c->fbDelayLengths[i]) < 0)
+			return NULL;
+	}
+
+	r->fbRamp = 0;
+
+	r->gate = (c->silenceThreshold > 0.f);
+	if (r->gate)
+	{
+		silenceGateInit(&r->silence, c->silenceThreshold, 0, 0.f, 1.f);
+		schroederReverbUpdateSilenceGate(r);
+	}
+
+	return r;
+}
+
+
+//	The whole reverberator is allocated as one block of memory
+SchroederReverb *createSchroederReverb(const SchroederReverbConfig *c)
+{
+	size_t size = schroederReverbArenaSize(c);
+	if (size == 0)
+		return NULL;
+
+	void *memory = malloc(size);
+	if (memory == NULL)
+		return NULL;
+
+	Arena arena;
+	SchroederReverb *r = NULL;
+
+	if (arenaInit(&arena, memory, size) == 0)
+		r = createSchroederReverbInArena(&arena, c);
+
+	if (r == NULL)
+	{
+		free(memory);
+		return NULL;
+	}
+
+	r->memory = memory;
+
+	return r;
+}
+
+
+//	Only for reverberators made with createSchroederReverb().  The struct itself lives in r->memory
+void deleteSchroederReverb(SchroederReverb *r)
+{
+	if (r == NULL) return;
+
+	free(r->memory);
+
+	return;
+}
+
+
+//	Clear every delay line back to silence, e.g. when switching to a different input
+void schroederReverbReset(SchroederReverb *r)
+{
+	if (r == NULL) return;
+
+	for (size_t i = 0; i < r->numAPCFs; ++i)
+		delayLineReset(r->ap[i]->M);
+
+	fbcfBankReset(r->fb);
+
+	if (r->gate)
+		silenceGateReset(&r->silence);
+
+	return;
+}
+
+
+//	Apply the output mixing matrix to n interleaved frames in place
+static void schroederReverbMix(const SchroederReverb *r, float32_t *y, size_t n)
+{
+	size_t numChannels = r->numChannels;
+	float32_t frame[SCHROEDER_REVERB_MAX_CHANNELS];
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		for (size_t k = 0; k < numChannels; ++k)
+			frame[k] = y[k];
+
+		for (size_t c = 0; c < numChannels; ++c)
+		{
+			const float32_t *row = &r->mixMatrix[c * numChannels];
+			float32_t acc = 0.f;
+
+			for (size_t k = 0; k < numChannels; ++k)
+				acc += row[k] * frame[k];
+
+			y[c] = acc;
+		}
+
+		y += numChannels;
+	}
+}
+
+
+//	Hand new parameters to the audio thread.  Called from the control thread (only one thread may call it), never
+//	blocks and never allocates.  The parameters take effect at the start of the next schroederReverbProcessBlock()
+int schroederReverbSetParams(SchroederReverb *r, const SchroederReverbParams *p)
+{
+	if ((r == NULL) || (p == NULL)) return -1;
+	if ((p->rt60 <= 0.f) || (p->roomSize <= 0.f) || (r->fs <= 0.f)) return -1;
+
+	r->paramSequence++;
+	__DMB();
+
+	r->pendingParams = *p;
+
+	__DMB();
+	r->paramSequence++;
+
+	return 0;
+}
+
+
+//	FBCF delay length for lane j at a room size of roomSize
+static size_t schroederReverbFBCFLength(const SchroederReverb *r, size_t j, float32_t roomSize)
+{
+	size_t M = (size_t)(((float32_t)r->fbBaseLength[j] * roomSize) + 0.5f);
+
+	if (M < 1)
+		M = 1;
+	if (M > r->fb->lines[j].capacity)
+		M = r->fb->lines[j].capacity;
+
+	return M;
+}
+
+
+//	Work out the feedback gains for the current RT60 and delay lengths in one batch.  g = 10^(-3M / (fs * rt60)),
+//	computed as 2^(k * M)
+static void schroederReverbUpdateGains(SchroederReverb *r)
+{
+	float32_t k = (-3.f * 3.321928095f) / (r->fs * r->rt60);
+
+	for (size_t j = 0; j < r->fb->N; ++j)
+		r->fbTargetAm[j] = -exp2f(k * (float32_t)r->fb->lines[j].M);
+
+	r->fbRamp = 1;
+
+	schroederReverbUpdateSilenceGate(r);
+}
+
+
+//	Called by the audio thread at the start of every block of n samples.  Picks up new parameters if they were set since
+//	the last block (and are not being written right now)
+static void schroederReverbApplyParams(SchroederReverb *r, size_t n)
+{
+	uint32_t sequence = r->paramSequence;
+
+	if ((sequence & 1) || (sequence == r->appliedSequence))
+		return;
+
+	__DMB();
+	SchroederReverbParams p = r->pendingParams;
+	__DMB();
+
+	//	The control thread wrote again while the parameters were being copied.  Try again on the next block
+	if (r->paramSequence != sequence)
+		return;
+
+	r->appliedSequence = sequence;
+	r->rt60 = p.rt60;
+	r->wetTarget = p.wet;
+	r->dryTarget = p.dry;
+
+	size_t M[SCHROEDER_REVERB_MAX_FBCFS];
+	int resize = 0;
+
+	for (size_t j = 0; j < r->fb->N; ++j)
+	{
+		M[j] = schroederReverbFBCFLength(r, j, p.roomSize);
+		resize |= (M[j] != r->fb->lines[j].M);
+	}
+
+	//	The FBCF taps move within their delay lines and are crossfaded while the gains for the new lengths are ramped in.
+	//	The gain and wet/dry ramps finish with the first maxBlockSize piece of the block, so the crossfade does too
+	if (resize)
+		fbcfBankSetLengths(r->fb, M, (n > r->maxBlockSize) ? r->maxBlockSize : n);
+
+	schroederReverbUpdateGains(r);
+}
+
+
+//	Run the FBCF bank, moving the feedback gains to their targets in SCHROEDER_REVERB_RAMP_STEP sample steps over
+//	the block if they have changed
+static int schroederReverbProcessFBCFs(SchroederReverb *r, const float32_t *x, float32_t *y, size_t n)
+{
+	FBCFBank *fb = r->fb;
+
+	if (!r->fbRamp)
+		return fbcfBankProcessBlockInterleaved(fb, x, y, r->numChannels, n);
+
+	float32_t startAm[SCHROEDER_REVERB_MAX_FBCFS];
+	size_t numSteps = (n + SCHROEDER_REVERB_RAMP_STEP - 1) / SCHROEDER_REVERB_RAMP_STEP;
+
+	for (size_t j = 0; j < fb->N; ++j)
+		startAm[j] = fb->am[j];
+
+	for (size_t step = 0; step < numSteps; ++step)
+	{
+		float32_t t = (float32_t)(step + 1) / (float32_t)numSteps;
+		size_t offset = step * SCHROEDER_REVERB_RAMP_STEP;
+		size_t count = ((n - offset) > SCHROEDER_REVERB_RAMP_STEP) ? SCHROEDER_REVERB_RAMP_STEP : (n - offset);
+
+		for (size_t j = 0; j < fb->N; ++j)
+			fb->am[j] = startAm[j] + ((r->fbTargetAm[j] - startAm[j]) * t);
+
+		if (fbcfBankProcessBlockInterleaved(fb, x + offset, y + (offset * r->numChannels), r->numChannels, count) < 0)
+			return -1;
+	}
+
+	r->fbRamp = 0;
+
+	return 0;
+}
+
+
+//	y = (wet * reverb) + (dry * x) for every channel, with wet and dry ramped linearly to their targets over the block.
+//	reverb holds numChannels interleaved samples per input sample and may be the same buffer as y
+static void schroederReverbMixWetDry(SchroederReverb *r, const float32_t *x, const float32_t *reverb, float32_t *y, size_t n)
+{
+	size_t numChannels = r->numChannels;
+
+	//	Fully wet and not changing, which is the default
+	if ((r->wet == 1.f) && (r->dry == 0.f) && (r->wetTarget == 1.f) && (r->dryTarget == 0.f))
+	{
+		if (reverb != y)
+			arm_copy_f32((float32_t *)reverb, y, n * numChannels);
+
+		return;
+	}
+
+	float32_t wetStep = (r->wetTarget - r->wet) / (float32_t)n;
+	float32_t dryStep = (r->dryTarget - r->dry) / (float32_t)n;
+	float32_t wet = r->wet;
+	float32_t dry = r->dry;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		wet += wetStep;
+		dry += dryStep;
+
+		float32_t input = dry * x[i];
+
+		for (size_t c = 0; c < numChannels; ++c)
+			y[(i * numChannels) + c] = (wet * reverb[(i * numChannels) + c]) + input;
+	}
+
+	r->wet = r->wetTarget;
+	r->dry = r->dryTarget;
+}
+
+
+//	Body of schroederReverbProcessBlock()
+static int schroederReverbProcess(SchroederReverb *r, const float32_t *x, float32_t *y, size_t n)
+{
+	while (n > 0)
+	{
+		size_t count = (n > r->maxBlockSize) ? r->maxBlockSize : n;
+
+		//	The reverb tail has died out and the input is still silent, so the filters would only output their response
+		//	to the input's resting level
+		if (r->gate && silenceGateProcess(&r->silence, x, count))
+		{
+			float32_t *settled = (r->numChannels == 1) ? r->scratch : y;
+			float32_t level = silenceGateLevel(&r->silence);
+
+			if (r->numChannels == 1)
+				arm_fill_f32(r->dcGain[0] * level, settled, count);
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					for (size_t c = 0; c < r->numChannels; ++c)
+						settled[(i * r->numChannels) + c] = r->dcGain[c] * level;
+				}
+			}
+
+			schroederReverbMixWetDry(r, x, settled, y, count);
+
+			x += count;
+			y += count * r->numChannels;
+			n -= count;
+			continue;
+		}
+
+		//	Run the audio through the APCF section
+		if (apcfT2CascadeProcessBlock(r->ap, r->numAPCFs, x, r->scratch, count) < 0)
+			return -1;
+
+		//	Run the result of the APCF section through the FBCF bank, which sums the outputs of each channel's FBCFs.
+		//	A single channel is processed in place in the scratch buffer so that x is still there for the dry signal
+		float32_t *reverb = (r->numChannels == 1) ? r->scratch : y;
+
+		if (schroederReverbProcessFBCFs(r, r->scratch, reverb, count) < 0)
+			return -1;
+
+		if (r->mix)
+			schroederReverbMix(r, reverb, count);
+
+		schroederReverbMixWetDry(r, x, reverb, y, count);
+
+		x += count;
+		y += count * r->numChannels;
+		n -= count;
+	}
+
+	return 0;
+}
+
+
+//	Process n samples of mono input through the reverberator.  y gets numChannels interleaved outputs per input sample.
+//	The allpass section is shared by every channel and all of the channels' FBCFs run together in one bank, so adding
+//	channels only adds comb lanes.  Blocks longer than maxBlockSize are processed in pieces of maxBlockSize samples.
+//	Flush-to-zero is on for the duration of the call (see Denormal.h).
+//	x and y may only point to the same buffer for a single channel reverberator
+int schroederReverbProcessBlock(SchroederReverb *r, const float32_t *x, float32_t *y, size_t n)
+{
+	if ((r == NULL) || (x == NULL) || (y == NULL)) return -1;
+
+	DenormalState denormalState = denormalGuardBegin();
+
+	schroederReverbApplyParams(r, n);
+	int status = schroederReverbProcess(r, x, y, n);
+
+	denormalGuardEnd(denormalState);
+
+	return status;
+}
+
+
+static size_t schroederReverbGCD(size_t a, size_t b)
+{
+	while (b != 0)
+	{
+		size_t t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+
+//	Build a delay set for every channel from one set of numFBCFs delay lengths, channel c getting every length
+//	increased by c * spread samples and then moved up to the next length that is coprime with every length picked
+//	before it, in any channel.  The whole bank then has mutually prime lengths, so no two combs (of the same or of
+//	different channels) line their echoes up, and no channel repeats another's lengths.  Lengths already mutually prime
+//	are kept, so channel 0 gets M itself when M is.  channelM must hold numFBCFs * numChannels entries
+void schroederReverbSpreadDelayLengths(const size_t *M, size_t numFBCFs, size_t numChannels, size_t spread, size_t *channelM)
+{
+	if ((M == NULL) || (channelM == NULL)) return;
+
+	size_t total = numFBCFs * numChannels;
+
+	for (size_t k = 0; k < total; ++k)
+	{
+		size_t length = M[k % numFBCFs] + ((k / numFBCFs) * spread);
+		size_t previous = 0;
+
+		//	Start over whenever the length is moved, until it is coprime with all of the lengths before it
+		while (previous < k)
+		{
+			if (schroederReverbGCD(length, channelM[previous]) != 1)
+			{
+				++length;
+				previous = 0;
+			}
+			else
+				++previous;
+		}
+
+		channelM[k] = length;
+	}
+
+	return;
+}
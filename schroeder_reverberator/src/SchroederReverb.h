@@ -0,0 +1,122 @@
+/*
+ * SchroederReverb.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_SCHROEDERREVERB_H_
+#define SRC_SCHROEDERREVERB_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+#include "Arena.h"
+#include "DelayLine.h"
+#include "CombFilter.h"
+#include "FBCFBank.h"
+#include "SilenceGate.h"
+
+
+#define SCHROEDER_REVERB_MAX_APCFS APCF_T2_CASCADE_MAX_STAGES
+#define SCHROEDER_REVERB_MAX_FBCFS FBCF_BANK_MAX_COMBS
+#define SCHROEDER_REVERB_MAX_CHANNELS 4
+
+//	Feedback gain changes are ramped over a block in steps of this many samples
+#define SCHROEDER_REVERB_RAMP_STEP 32
+
+
+//	Parameters for createSchroederReverb().  The input goes through numAPCFs allpass comb filters in series, then
+//	into numFBCFs feedback comb filters per output channel, in parallel, whose outputs are summed per channel.
+//	fbDelayLengths and fbGains (the feedback gains) hold numFBCFs entries per channel, channel 0 first, and every delay
+//	length must be above 0.  Giving every channel its own delay lengths decorrelates the channels, and
+//	schroederReverbSpreadDelayLengths() builds such sets, mutually prime across the whole bank.  The channel outputs are then mixed by mixMatrix
+//	(numChannels x numChannels, row major, output row by input column), or passed straight through if it is NULL.
+//	fbFormat and fbFullScale select how the FBCF delay lines are stored (see DelayLineFormat).
+//	The FBCF delay lines are allocated maxRoomSize times longer than fbDelayLengths so that the room size can be
+//	raised up to maxRoomSize at runtime.  fs is the sample rate the RT60 is worked out for.
+//	If silenceThreshold is above 0, the filters are skipped once the input has stayed within it of its resting level
+//	(see SilenceGate) for longer than the reverb tail takes to decay below it.  Until the input comes back the wet
+//	signal is the reverberator's settled response to the resting level, so the output doesn't step
+typedef struct
+{
+	size_t numAPCFs;
+	const size_t *apDelayLengths;
+	float32_t apGain;
+	size_t numFBCFs;
+	const size_t *fbDelayLengths;
+	const float32_t *fbGains;
+	size_t numChannels;
+	const float32_t *mixMatrix;
+	size_t maxBlockSize;
+	DelayLineFormat fbFormat;
+	float32_t fbFullScale;
+	float32_t maxRoomSize;
+	float32_t fs;
+	float32_t silenceThreshold;
+}SchroederReverbConfig;
+
+
+//	Runtime controls.  rt60 is the time in seconds the FBCFs take to decay by 60 dB.  roomSize scales the FBCF delay
+//	lengths given in the config (1 = as given, up to maxRoomSize).  wet and dry are the gains of the reverberated and
+//	the unprocessed signal in the output.
+//	Feedback gain and wet/dry changes are ramped in over one block.  A room size change moves the FBCFs' read taps
+//	within their delay lines, which keep their samples, and crossfades each FBCF from its old tap to its new one over
+//	one block, so the reverb tail carries on at the new size
+typedef struct
+{
+	float32_t rt60;
+	float32_t roomSize;
+	float32_t wet;
+	float32_t dry;
+}SchroederReverbParams;
+
+
+//	Schroeder Reverberator.  Every filter, delay line and scratch buffer the reverberator uses is allocated when it is
+//	created, so any number of instances can run side by side and schroederReverbProcessBlock() never allocates.
+//	New parameters are handed from the control thread to the audio thread through pendingParams, guarded by
+//	paramSequence (odd while a write is in progress), and are picked up at the start of the next block
+typedef struct
+{
+	size_t numAPCFs;
+	size_t numFBCFs;
+	size_t numChannels;
+	size_t maxBlockSize;
+	int mix;
+	float32_t mixMatrix[SCHROEDER_REVERB_MAX_CHANNELS * SCHROEDER_REVERB_MAX_CHANNELS];
+	APCF_T2 *ap[SCHROEDER_REVERB_MAX_APCFS];
+	FBCFBank *fb;
+	float32_t *scratch;
+	float32_t fs;
+	float32_t rt60;
+	size_t fbBaseLength[SCHROEDER_REVERB_MAX_FBCFS];
+	float32_t fbTargetAm[SCHROEDER_REVERB_MAX_FBCFS];
+	int fbRamp;
+	float32_t wet;
+	float32_t dry;
+	float32_t wetTarget;
+	float32_t dryTarget;
+	volatile uint32_t paramSequence;
+	uint32_t appliedSequence;
+	SchroederReverbParams pendingParams;
+	int gate;
+	SilenceGate silence;
+	float32_t dcGain[SCHROEDER_REVERB_MAX_CHANNELS];	//	Gain from a constant input to each channel's wet output
+	void *memory;				//	Block everything was allocated from by createSchroederReverb(), NULL if created in an arena
+}SchroederReverb;
+
+
+//	Arena bytes used by a SchroederReverb on top of its filters
+#define SCHROEDER_REVERB_BASE_ARENA_SIZE(maxBlockSize) (ARENA_ALIGN(sizeof(SchroederReverb)) + ARENA_ALIGN((maxBlockSize) * sizeof(float32_t)))
+
+
+SchroederReverb	*createSchroederReverb(const SchroederReverbConfig *c);
+SchroederReverb	*createSchroederReverbInArena(Arena *arena, const SchroederReverbConfig *c);
+size_t			schroederReverbArenaSize(const SchroederReverbConfig *c);
+void			deleteSchroederReverb(SchroederReverb *r);
+void			schroederReverbReset(SchroederReverb *r);
+int				schroederReverbSetParams(SchroederReverb *r, const SchroederReverbParams *p);
+int				schroederReverbProcessBlock(SchroederReverb *r, const float32_t *x, float32_t *y, size_t n);
+void			schroederReverbSpreadDelayLengths(const size_t *M, size_t numFBCFs, size_t numChannels, size_t spread, size_t *channelM);
+
+
+
+#endif /* SRC_SCHROEDERREVERB_H_ */
@@ -0,0 +1,50 @@
+/*
+ * SilenceGate.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SRC_SILENCEGATE_H_
+#define SRC_SILENCEGATE_H_
+
+#include "arm_math.h"
+#include "stdlib.h"
+
+
+//	Time constant, in samples, of the tracker that follows the input's resting level
+#define SILENCE_GATE_DC_SAMPLES 8192
+
+
+//	Tracks whether a filter's input has been silent for long enough that its output has decayed below threshold, so
+//	that the filter can be skipped until the input comes back.  Silence is measured around the input's resting level,
+//	which is tracked by a slow average (ADC samples idle at mid-scale, not 0): a block is silent when the RMS of its
+//	deviation from that level is at most threshold.  The tail after the input goes silent is
+//	minTail + (decayTime * ln(peak * maxGain / threshold)) samples, where peak is the largest deviation since the last
+//	bypass, maxGain bounds how much louder than its input the filter's output can get and decayTime is the number of
+//	samples the output takes to fall by a factor of e.  While bypassed, the filter's output should be its DC gain times
+//	silenceGateLevel()
+typedef struct
+{
+	float32_t threshold;
+	size_t minTail;
+	float32_t decayTime;
+	float32_t maxGain;
+	float32_t dc;				//	Resting level of the input
+	int dcValid;				//	dc is only set by the first block
+	float32_t peak;
+	size_t tailLength;
+	size_t silentSamples;
+	int bypassed;
+}SilenceGate;
+
+
+int			silenceGateInit(SilenceGate *g, float32_t threshold, size_t minTail, float32_t decayTime, float32_t maxGain);
+void		silenceGateSetDecay(SilenceGate *g, size_t minTail, float32_t decayTime, float32_t maxGain);
+void		silenceGateReset(SilenceGate *g);
+int			silenceGateProcess(SilenceGate *g, const float32_t *x, size_t n);
+float32_t	silenceGateLevel(const SilenceGate *g);
+float32_t	silenceGateDecayTime(float32_t feedbackGain, size_t M);
+float32_t	silenceGateLoopGain(float32_t feedbackGain);
+
+
+#endif /* SRC_SILENCEGATE_H_ */
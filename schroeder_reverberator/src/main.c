@@ -6,8 +6,8 @@
 #include "em_vdac.h"
 #include "arm_math.h"
 
-#include "DelayLine.h"
-#include "CombFilter.h"
+#include "SchroederReverb.h"
+#include "Arena.h"
 
 #define NUM_BUFFERS 4
 #define BUFFER_SIZE 2048
@@ -16,6 +16,20 @@
 #define NUM_APCFS 3
 #define NUM_FBCFS 4
 
+//	Sample storage format of the FBCF bank's delay lines, which take up most of the reverberator's RAM.
+//	DELAY_LINE_FORMAT_Q15 and DELAY_LINE_FORMAT_F16 halve it at the cost of converting samples on the way in and out
+#define FB_STORAGE_FORMAT DELAY_LINE_FORMAT_F32
+
+//	Largest magnitude a FBCF delay line has to hold when stored as DELAY_LINE_FORMAT_Q15.  A 12-bit input through a
+//	feedback gain of 0.8 stays below 4096 / (1 - 0.8) = 20480
+#define FB_FULL_SCALE 32768.f
+
+//	The reverberator stops processing once its input has stayed within this RMS level of its resting level (mid-scale
+//	for the ADC, tracked as it goes) for longer than its tail takes to decay below it: 1 LSB of the 12-bit DAC.  It
+//	then outputs its settled response to the resting level.  Raise it above the ADC's idle noise if the reverberator
+//	never stops.  Set to 0 to always process
+#define SILENCE_THRESHOLD 1.f
+
 //  Create buffers
 volatile static float32_t buffer[NUM_BUFFERS][BUFFER_SIZE];
 
@@ -39,15 +53,36 @@ volatile uint32_t dacBufferIndex;
 float32_t fs = 30000.f;
 
 
-//	Declare comb filters and parameters for Schroeder Reverberator
-APCF *ap[NUM_APCFS];
-FBCF *fb[NUM_FBCFS];
+//	Declare the Schroeder Reverberator and its parameters
+SchroederReverb *reverb;
 
-size_t APDelayLengths[NUM_APCFS] = {347, 113, 37};
+#define AP_DELAY_LENGTH_0 347
+#define AP_DELAY_LENGTH_1 113
+#define AP_DELAY_LENGTH_2 37
+#define FB_DELAY_LENGTH_0 1687
+#define FB_DELAY_LENGTH_1 1601
+#define FB_DELAY_LENGTH_2 2053
+#define FB_DELAY_LENGTH_3 2251
+
+size_t APDelayLengths[NUM_APCFS] = {AP_DELAY_LENGTH_0, AP_DELAY_LENGTH_1, AP_DELAY_LENGTH_2};
 float32_t APGain = 0.7f;
-size_t FBDelayLengths[NUM_FBCFS] = {1687, 1601, 2053, 2251};
+size_t FBDelayLengths[NUM_FBCFS] = {FB_DELAY_LENGTH_0, FB_DELAY_LENGTH_1, FB_DELAY_LENGTH_2, FB_DELAY_LENGTH_3};
 float32_t FBGains[NUM_FBCFS] = {0.773f, 0.802f, 0.753f, 0.733f};
 
+//	The reverberator, its comb filters and delay line buffers are placed in this one block of memory so that the
+//	reverberator's RAM usage is known at link time and nothing is allocated on the heap
+#define AP_ARENA_SIZE(M) APCF_T2_ARENA_SIZE(M)
+
+#define FB_DELAY_LENGTH_TOTAL (FB_DELAY_LENGTH_0 + FB_DELAY_LENGTH_1 + FB_DELAY_LENGTH_2 + FB_DELAY_LENGTH_3)
+#define FB_ARENA_SIZE	((FB_STORAGE_FORMAT == DELAY_LINE_FORMAT_F32) ? FBCF_BANK_ARENA_SIZE(FB_DELAY_LENGTH_TOTAL) : \
+						FBCF_BANK_COMPACT_ARENA_SIZE(NUM_FBCFS, FB_DELAY_LENGTH_TOTAL))
+
+#define REVERB_ARENA_SIZE	(SCHROEDER_REVERB_BASE_ARENA_SIZE(BUFFER_SIZE) + AP_ARENA_SIZE(AP_DELAY_LENGTH_0) + AP_ARENA_SIZE(AP_DELAY_LENGTH_1) + \
+							AP_ARENA_SIZE(AP_DELAY_LENGTH_2) + FB_ARENA_SIZE)
+
+static uint8_t reverbMemory[REVERB_ARENA_SIZE] __ALIGNED(ARENA_ALIGNMENT);
+Arena reverbArena;
+
 
 static void setupSamplingTimer()
 {
@@ -134,46 +169,6 @@ void transferBufferToQueue(volatile float32_t *outgoingBuffer, volatile float32_
 }
 
 
-//	Function to shift in a sample into the Schroeder Reverberator and get the next output
-int shiftSchroederReverberator(float32_t *x, float32_t *y)
-{
-	//	Shift in the audio input into the APCF section
-	float32_t filterInput = *x;
-	for (int i = 0; i < NUM_APCFS; ++i)
-		apcfShift(ap[i], filterInput, &filterInput);
-
-	//	Shift in result of the APCF section to the FBCF bank
-	//	Also apply the mixing matrix to the output of the FBCF bank
-	float32_t sum = 0.f;
-
-	for (int i = 0; i < NUM_FBCFS; ++i)
-	{
-		float32_t fbcfOut = 0.f;
-		fbcfShift(fb[i], filterInput, &fbcfOut);
-
-		sum += fbcfOut;
-	}
-
-	*y = sum;
-
-	return 0;
-}
-
-
-void deleteSchroederReverberatorFilters()
-{
-	for (int i = 0; i < NUM_APCFS; ++i)
-		deleteAPCF(ap[i]);
-
-	for (int i = 0; i < NUM_FBCFS; ++i)
-		deleteFBCF(fb[i]);
-}
-
-
-
-
-
-
 int main(void)
 {
   /* Chip errata */
@@ -199,26 +194,33 @@ int main(void)
   dacBufferIndex = 0;
 
 
-  //	Allocate and initialize the comb filters here
-  for (int i = 0; i < NUM_APCFS; ++i)
-  {
-	  ap[i] = createAPCF(APDelayLengths[i], -APGain, APGain);
-	  if (ap[i] == NULL)
-	  {
-		  deleteSchroederReverberatorFilters();
-		  return 0;
-	  }
-  }
+  //	Allocate and initialize the Schroeder Reverberator here
+  SchroederReverbConfig reverbConfig;
 
-  for (int i = 0; i < NUM_FBCFS; ++i)
-  {
-	  fb[i] = createFBCF(FBDelayLengths[i], 1.f, -FBGains[i]);
-	  if (fb[i] == NULL)
-	  {
-		  deleteSchroederReverberatorFilters();
-		  return 0;
-	  }
-  }
+  reverbConfig.numAPCFs = NUM_APCFS;
+  reverbConfig.apDelayLengths = APDelayLengths;
+  reverbConfig.apGain = APGain;
+  reverbConfig.numFBCFs = NUM_FBCFS;
+  reverbConfig.fbDelayLengths = FBDelayLengths;
+  reverbConfig.fbGains = FBGains;
+  reverbConfig.numChannels = 1;
+  reverbConfig.mixMatrix = NULL;
+  reverbConfig.maxBlockSize = BUFFER_SIZE;
+  reverbConfig.fbFormat = FB_STORAGE_FORMAT;
+  reverbConfig.fbFullScale = FB_FULL_SCALE;
+  reverbConfig.maxRoomSize = 1.f;
+  reverbConfig.fs = fs;
+  reverbConfig.silenceThreshold = SILENCE_THRESHOLD;
+
+  if (schroederReverbArenaSize(&reverbConfig) > sizeof(reverbMemory))
+	  return 0;
+
+  if (arenaInit(&reverbArena, reverbMemory, sizeof(reverbMemory)) < 0)
+	  return 0;
+
+  reverb = createSchroederReverbInArena(&reverbArena, &reverbConfig);
+  if (reverb == NULL)
+	  return 0;
 
 
   TIMER_Enable(TIMER0, true);
@@ -230,9 +232,9 @@ int main(void)
 	  //  Check to make sure there is a buffer available for processing
 	  if (processingQueue[processingQueueHead] != NULL)
 	  {
-		  //	Shift audio data into the Schroeder Reverberator and get its output
-		  for (int i = 0; i < BUFFER_SIZE; ++i)
-			  shiftSchroederReverberator(&processingQueue[processingQueueHead][i], &processingQueue[processingQueueHead][i]);
+		  //	Process the audio block with the Schroeder Reverberator
+		  float32_t *block = (float32_t *)processingQueue[processingQueueHead];
+		  schroederReverbProcessBlock(reverb, block, block, BUFFER_SIZE);
 
 	      transferBufferToQueue(processingQueue[processingQueueHead], dacQueue, &dacQueueTail);
 
@@ -241,9 +243,7 @@ int main(void)
 	  }
   }
 
-  //  Remember to release any memory that you've allocated!
-  deleteSchroederReverberatorFilters();
-
+  //  The reverberator lives in reverbMemory, so there is nothing to release
 }
 
 